@@ -56,6 +56,13 @@ typedef struct {
     int system_state; // 0=normal, 1=charging_anim, 2=charging_overlay, 3=demo, 4=off
 } battery_info_t;
 
+// Ein Messwert aus GPIO + Fuel-Gauge - gelesen im Housekeeping-Task, angewendet im UI-Task
+struct BatterySample {
+    bool charging, power_switch_on;
+    bool soc_read, soc_valid;   // Fuel-Gauge abgefragt / Antwort gültig
+    uint8_t soc;
+};
+
 // =============================================================================
 // GLOBAL VARIABLES
 // =============================================================================
@@ -74,11 +81,18 @@ static lv_obj_t *charging_spinner = nullptr;
 static bool charging_backlight_active = true;
 static bool charging_timer_started = false;
 
+// Low-Power-Lauf (low_power.h): Display bleibt aus, Fuel-Gauge seltener abfragen
+bool battery_low_power = false;
+
 // =============================================================================
 // FUNCTION DECLARATIONS
 // =============================================================================
 void battery_init();
 void battery_system_update();
+bool battery_sample_due();                               // Abfrage-Intervall (500 ms, Low-Power seltener)
+uint32_t battery_sample_wait_ms();                       // Bis zur nächsten fälligen Abfrage (Idle-Planung)
+void battery_read_sample(BatterySample &sample);         // GPIO + I2C, kein LVGL
+void battery_apply_sample(const BatterySample &sample);  // Zustandsmaschine + Widgets (nur UI-Task)
 void battery_set_level(uint8_t level);
 void battery_set_charging(bool charging);
 uint8_t battery_get_level();
@@ -95,6 +109,10 @@ void update_charging_screen();
 void backlight_on();
 void backlight_off();
 
+// Housekeeping-Task (tasks.h)
+extern bool housekeeping_running();
+extern bool battery_sample_receive(BatterySample &sample);
+
 // =============================================================================
 // IMPLEMENTATION
 // =============================================================================
@@ -372,13 +390,44 @@ void update_battery_widget(lv_obj_t *battery_widget) {
 }
 
 void battery_system_update() {
+    BatterySample sample;
+    
+    // Mit Housekeeping-Task kommt das Sample über die Queue - I2C blockiert das UI nicht mehr
+    if (housekeeping_running()) {
+        if (battery_sample_receive(sample)) battery_apply_sample(sample);
+        return;
+    }
+    if (!battery_sample_due()) return;
+    battery_read_sample(sample);
+    battery_apply_sample(sample);
+}
+
+bool battery_sample_due() {
     unsigned long current_time = millis();
-    if (current_time - last_battery_update <= 500) return;
+    unsigned long update_interval = battery_low_power ? BATTERY_LOW_POWER_UPDATE_MS : BATTERY_UPDATE_MS;
+    if (current_time - last_battery_update <= update_interval) return false;
     
     last_battery_update = current_time;
-    
-    bool charging = read_charging_status_hw();
-    bool power_switch_on = read_power_switch_status_hw();
+    return true;
+}
+
+uint32_t battery_sample_wait_ms() {
+    unsigned long update_interval = battery_low_power ? BATTERY_LOW_POWER_UPDATE_MS : BATTERY_UPDATE_MS;
+    unsigned long elapsed = millis() - last_battery_update;
+    return elapsed > update_interval ? 0 : (uint32_t)(update_interval - elapsed + 1);
+}
+
+void battery_read_sample(BatterySample &sample) {
+    sample.charging = read_charging_status_hw();
+    sample.power_switch_on = read_power_switch_status_hw();
+    sample.soc_read = battery_state.max17048_available;
+    sample.soc_valid = sample.soc_read && max17048_read_soc(sample.soc);
+}
+
+void battery_apply_sample(const BatterySample &sample) {
+    unsigned long current_time = millis();
+    bool charging = sample.charging;
+    bool power_switch_on = sample.power_switch_on;
     battery_state.is_charging = charging;
     battery_state.is_power_switch_on = power_switch_on;
     
@@ -402,16 +451,13 @@ void battery_system_update() {
 
             hide_charging_overlay();
             hide_off_screen();
-            backlight_on();
-            if (battery_state.max17048_available) {
-                uint8_t real_soc;
-                if (max17048_read_soc(real_soc)) {
-                    battery_state.real_level = real_soc;
-                    battery_set_level(real_soc);
-                } else {
-                    battery_state.system_state = 3;
-                    battery_state.max17048_available = false;
-                }
+            if (!battery_low_power) backlight_on();
+            if (sample.soc_valid) {
+                battery_state.real_level = sample.soc;
+                battery_set_level(sample.soc);
+            } else if (sample.soc_read) {
+                battery_state.system_state = 3;
+                battery_state.max17048_available = false;
             }
             break;
             
@@ -425,10 +471,8 @@ void battery_system_update() {
             hide_off_screen();
             if (current_time - last_battery_animation > 800) {
                 last_battery_animation = current_time;
+                if (sample.soc_valid) battery_state.real_level = sample.soc;
                 uint8_t real_soc = battery_state.real_level;
-                if (battery_state.max17048_available) {
-                    if (max17048_read_soc(real_soc)) battery_state.real_level = real_soc;
-                }
                 
                 uint8_t current_display = battery_state.level;
                 uint8_t new_level = battery_animation_increasing ? current_display + 3 : current_display - 3;
@@ -446,12 +490,9 @@ void battery_system_update() {
             show_charging_overlay(); 
             hide_off_screen();
             update_charging_screen();
-            if (battery_state.max17048_available) {
-                uint8_t real_soc;
-                if (max17048_read_soc(real_soc)) {
-                    battery_state.real_level = real_soc;
-                    battery_set_level(real_soc);
-                }
+            if (sample.soc_valid) {
+                battery_state.real_level = sample.soc;
+                battery_set_level(sample.soc);
             }
             break;
             
@@ -461,7 +502,7 @@ void battery_system_update() {
             charging_backlight_active = true;
             
             hide_charging_overlay();
-            backlight_on();
+            if (!battery_low_power) backlight_on();
             hide_off_screen();
             if (battery_demo_enabled && (current_time - last_battery_animation > 2000)) {
                 last_battery_animation = current_time;
@@ -482,12 +523,9 @@ void battery_system_update() {
             hide_charging_overlay();
             backlight_on();
             show_off_screen();
-            if (battery_state.max17048_available) {
-                uint8_t real_soc;
-                if (max17048_read_soc(real_soc)) {
-                    battery_state.real_level = real_soc;
-                    battery_set_level(real_soc);
-                }
+            if (sample.soc_valid) {
+                battery_state.real_level = sample.soc;
+                battery_set_level(sample.soc);
             }
             break;
     }
@@ -0,0 +1,96 @@
+/*
+=============================================================================
+ble_queue.h - Lock-freie SPSC-Ringe zwischen BLE-Stack und Loop
+=============================================================================
+onWrite() läuft im Task des BLE-Stacks. Dort wird der Befehl nur noch mit
+Empfangszeit in einen festen Slot kopiert - keine Allokation, kein Lock,
+kein Zugriff auf runtime oder LVGL. Die Loop leert den Ring und arbeitet die
+Befehle ab; Antworten gehen über einen zweiten Ring zurück und werden am
+Ende von bluetooth_update() per notify() verschickt.
+
+Je Ring genau ein Produzent und ein Konsument: head schreibt nur der
+Produzent, tail nur der Konsument. Acquire/Release auf den Indizes reicht,
+damit der Slot-Inhalt vor dem Index sichtbar ist.
+=============================================================================
+*/
+
+#ifndef BLE_QUEUE_H
+#define BLE_QUEUE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =============================================================================
+// QUEUE CONFIGURATION
+// =============================================================================
+#define BLE_QUEUE_SIZE          8      // Slots je Ring (Zweierpotenz)
+#define BLE_MESSAGE_MAX_LEN     512    // Max. Länge eines ATT-Werts
+
+struct BleMessage {
+  uint64_t rx_us;                      // Empfangszeit (Trigger-Zeitbasis), 0 bei Antworten
+  uint16_t length;
+  char text[BLE_MESSAGE_MAX_LEN + 1];
+};
+
+struct BleRing {
+  BleMessage slots[BLE_QUEUE_SIZE];
+  uint32_t head;                       // Nächster Schreib-Slot (nur Produzent)
+  uint32_t tail;                       // Nächster Lese-Slot (nur Konsument)
+  uint32_t dropped;                    // Ring voll - verworfen (nur Produzent)
+  uint32_t high_water;                 // Max. Füllstand (nur Produzent)
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void ble_ring_reset(BleRing &ring);    // Nur wenn keine Seite aktiv ist
+bool ble_ring_push(BleRing &ring, const char *text, size_t length, uint64_t rx_us);   // Produzent
+const BleMessage* ble_ring_peek(BleRing &ring);    // Konsument, nullptr = leer
+void ble_ring_pop(BleRing &ring);                  // Konsument, nach peek
+uint32_t ble_ring_count(BleRing &ring);
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+void ble_ring_reset(BleRing &ring) {
+  ring.head = 0;
+  ring.tail = 0;
+  ring.dropped = 0;
+  ring.high_water = 0;
+}
+
+bool ble_ring_push(BleRing &ring, const char *text, size_t length, uint64_t rx_us) {
+  uint32_t head = ring.head;
+  uint32_t tail = __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE);
+  if (head - tail >= BLE_QUEUE_SIZE) {
+    ring.dropped++;
+    return false;
+  }
+
+  BleMessage &slot = ring.slots[head % BLE_QUEUE_SIZE];
+  if (length > BLE_MESSAGE_MAX_LEN) length = BLE_MESSAGE_MAX_LEN;
+  memcpy(slot.text, text, length);
+  slot.text[length] = '\0';
+  slot.length = (uint16_t)length;
+  slot.rx_us = rx_us;
+
+  __atomic_store_n(&ring.head, head + 1, __ATOMIC_RELEASE);
+  ring.high_water = max(ring.high_water, head + 1 - tail);
+  return true;
+}
+
+const BleMessage* ble_ring_peek(BleRing &ring) {
+  uint32_t tail = ring.tail;
+  if (__atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) == tail) return nullptr;
+  return &ring.slots[tail % BLE_QUEUE_SIZE];
+}
+
+void ble_ring_pop(BleRing &ring) {
+  __atomic_store_n(&ring.tail, ring.tail + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t ble_ring_count(BleRing &ring) {
+  return __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE);
+}
+
+#endif // BLE_QUEUE_H
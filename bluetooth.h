@@ -13,6 +13,7 @@ bluetooth.h - BLE Remote Control System
 #include <BLE2902.h>
 #include "config.h"
 #include "state_machine.h"
+#include "ble_queue.h"
 
 // =============================================================================
 // BLE CONFIGURATION
@@ -22,19 +23,43 @@ bluetooth.h - BLE Remote Control System
 #define BLE_CHARACTERISTIC_UUID "87654321-4321-4321-4321-cba987654321"
 
 // BLE Commands - App Remote Control
-#define BLE_CMD_TIMER_REMOTE    "TIMER:"      // Format: TIMER:delay:release:start (TIMER:5:2:1)
+#define BLE_CMD_TIMER_REMOTE    "TIMER:"      // Format: TIMER:delay:release:start (TIMER:5:2.5:1, release in s mit Zehnteln)
 #define BLE_CMD_TLAPSE_REMOTE   "TLAPSE:"     // Format: TLAPSE:total:frames:start (TLAPSE:120:30:1)  
 #define BLE_CMD_INTERVAL_REMOTE "INTERVAL:"   // Format: INTERVAL:interval:start (INTERVAL:10:1)
 #define BLE_CMD_SIMPLE_TRIGGER  "SIMPLE"     // Simple immediate trigger
 #define BLE_CMD_CANCEL_ALL      "CANCEL"     // Cancel any running timer/tlapse/interval
 #define BLE_CMD_DISCONNECT      "DISCONNECT"
 #define BLE_CMD_STATUS          "STATUS"
+#define BLE_CMD_CATCHUP         "CATCHUP:"    // Format: CATCHUP:SKIP | CATCHUP:FIRE | CATCHUP:SHIFT
+#define BLE_CMD_RATES           "RATES"       // Max. Frames/s je Ausgabekanal
+#define BLE_CMD_SEQUENCE        "SEQ:"        // Format: SEQ:<program> (SEQ:D5000,B5@500*3)
+#define BLE_CMD_FOCUS           "FOCUS:"      // Format: FOCUS:every_frame:lead_ms:duration_ms (FOCUS:1:2000:2500)
+#define BLE_CMD_LAG             "LAG"         // Format: LAG | LAG:USE:i | LAG:SET:i:ms:name | LAG:MEASURE
+#define BLE_CMD_BURST           "BURST:"      // Format: BURST:count:rate_hz:pulse_ms:start (BURST:10:20:20:1)
+#define BLE_CMD_EXT             "EXT"         // Format: EXT | EXT:ARM | EXT:FIRE | EXT:delay_ms:lockout_ms:servo (EXT:0:500:1)
+#define BLE_CMD_POWER           "POWER"       // Format: POWER | POWER:enabled (POWER:1) | POWER:DEEP:enabled
+#define BLE_CMD_CLOCK           "CLOCK"       // Format: CLOCK | CLOCK:epoch_ms:tz_min (CLOCK:1760594400000:120)
+#define BLE_CMD_START_AT        "START_AT:"   // Format: START_AT:epoch_s:mode (START_AT:1760594400:L, mode T/L/I)
+#define BLE_CMD_PAUSE           "PAUSE"       // T-Lapse/Interval/Sequence anhalten
+#define BLE_CMD_RESUME          "RESUME"      // Format: RESUME | RESUME:GRID | RESUME:SHIFT | RESUME_MODE:GRID|SHIFT
+#define BLE_CMD_RAMP            "RAMP"        // Format: RAMP | RAMP:curve | RAMP:curve:s@ms,s@ms,...:start (RAMP:S:0@2000,3600@20000:1)
+#define BLE_CMD_OUTPUTS         "OUTPUTS"     // Format: OUTPUTS | OUTPUT:n:type:pin:focus:offset_ms:width_ms (OUTPUT:2:O:10:-1:1:600, type S/O/-)
+#define BLE_CMD_SYNC            "SYNC"        // Format: SYNC (Runde starten) | SYNC:t1:t2:t3 (Master-Antwort, µs) | SYNC_STATUS | SYNC_RESET
+#define BLE_CMD_SYNC_AT         "SYNC_AT:"    // Format: SYNC_AT:master_us:mode (SYNC_AT:1760594400000000:L, mode T/L/I)
 
 // BLE Response Codes
 #define BLE_RESP_OK             "OK:"
 #define BLE_RESP_ERROR          "ERROR:"
 #define BLE_RESP_STATUS         "STATUS:"
 
+#define BLE_DISCONNECT_GRACE_MS 100   // Letzte Antwort vor dem Trennen verschicken
+
+// Verbindungswechsel aus den Server-Callbacks - UI-Arbeit erledigt bluetooth_update()
+enum BLELinkEvent {
+  BLE_LINK_CONNECTED    = 1,
+  BLE_LINK_DISCONNECTED = 2
+};
+
 // =============================================================================
 // BLE STATE
 // =============================================================================
@@ -81,6 +106,9 @@ void bluetooth_enable();
 void bluetooth_disable();
 void bluetooth_update();
 void bluetooth_disconnect_client();
+void bluetooth_handle_link_events();
+void bluetooth_process_commands();   // Befehle aus dem RX-Ring abarbeiten (Loop)
+void ble_flush_responses();          // Antworten aus dem TX-Ring per notify()
 
 // BLE Server Callbacks
 class RS1ServerCallbacks;
@@ -95,17 +123,28 @@ void update_ble_overlay_display();
 // Command Processing
 void process_ble_command(String command);
 void send_ble_response(String response);
-void start_remote_timer(int delay, int release);
-void start_remote_tlapse(int total, int frames);
-void start_remote_interval(int interval);
+void start_remote_timer(int delay, uint32_t release_ms);
+bool start_remote_tlapse(int total, int frames);
+bool start_remote_interval(int interval);
 String get_device_status();
-bool parse_timer_command(String command, int &delay, int &release, bool &start);
+bool parse_timer_command(String command, int &delay, uint32_t &release_ms, bool &start);
 bool parse_tlapse_command(String command, int &total, int &frames, bool &start);
 bool parse_interval_command(String command, int &interval, bool &start);
+bool parse_burst_command(String command, int &count, int &rate, int &pulse, bool &start);
 
 // Event Callbacks
 void ble_disconnect_cb(lv_event_t *e);
 
+// Uhrzeit + geplanter Start (wall_clock.h)
+extern void wall_clock_set(int64_t epoch_us, int32_t tz_offset_s);
+extern bool wall_clock_start_at(int64_t epoch_us, TimerExecutionMode mode);
+extern String wall_clock_status_string();
+
+// Low-Power-Lauf (low_power.h)
+extern void set_low_power(bool enabled);
+extern void set_deep_sleep(bool enabled);
+extern String low_power_status_string();
+
 // =============================================================================
 // BLE SYSTEM STATE
 // =============================================================================
@@ -121,6 +160,17 @@ BLESystemState ble_state = {
 
 BLEServer* ble_server = nullptr;
 BLECharacteristic* ble_characteristic = nullptr;
+uint64_t ble_command_rx_us = 0;     // Empfangszeit des aktuellen Befehls (Trigger-Zeitbasis)
+
+// BLE-Task -> Loop (Befehle) und Loop -> notify (Antworten)
+BleRing ble_rx_ring;
+BleRing ble_tx_ring;
+uint32_t ble_rx_dropped_reported = 0;
+uint8_t ble_link_events = 0;          // BLELinkEvent-Bits, atomar gesetzt/abgeholt
+bool ble_disconnect_pending = false;
+unsigned long ble_disconnect_at = 0;
+
+extern void low_power_wake_loop();   // low_power.h - Loop nach Befehl/Verbindungswechsel sofort wecken
 
 // UI Objects
 lv_obj_t *ble_overlay = nullptr;
@@ -140,27 +190,18 @@ class RS1ServerCallbacks: public BLEServerCallbacks {
     ble_state.connection_start_time = millis();
     ble_state.last_heartbeat = millis();
     
-    DEBUG_PRINTLN("BLE Client connected - App can control device remotely");
-    show_ble_overlay();
-    
-    // Send welcome message with device status
-    send_ble_response("OK:CONNECTED:REMOTE_CONTROL_READY");
+    // Overlay und Begrüßung übernimmt die Loop
+    __atomic_or_fetch(&ble_link_events, BLE_LINK_CONNECTED, __ATOMIC_RELEASE);
+    low_power_wake_loop();
   }
 
   void onDisconnect(BLEServer* server) {
     ble_state.client_connected = false;
     ble_state.connection_state = BLE_ADVERTISING;
     ble_state.control_mode = BLE_CONTROL_NONE;    // Return to device-only control
-    ble_state.connected_device_name = "";
     
-    DEBUG_PRINTLN("BLE Client disconnected - Device operating independently");
-    hide_ble_overlay();
-    
-    // Cancel any running remote timers if they were started via BLE
-    if (runtime.state != TIMER_IDLE) {
-      // Let the user decide if they want to cancel - don't auto-cancel
-      DEBUG_PRINTLN("Timer still running - user can cancel manually if needed");
-    }
+    __atomic_or_fetch(&ble_link_events, BLE_LINK_DISCONNECTED, __ATOMIC_RELEASE);
+    low_power_wake_loop();
     
     // Restart advertising
     server->startAdvertising();
@@ -169,13 +210,16 @@ class RS1ServerCallbacks: public BLEServerCallbacks {
 
 class RS1CharacteristicCallbacks: public BLECharacteristicCallbacks {
   void onWrite(BLECharacteristic *characteristic) {
-    String command = characteristic->getValue().c_str();
-    command.trim();
-    
-    DEBUG_PRINTF("BLE Command received: %s\n", command.c_str());
+    uint64_t rx_us = trigger_clock_now_us();   // t4 für den Zeitabgleich - vor jeder weiteren Arbeit
     ble_state.last_heartbeat = millis();
     
-    process_ble_command(command);
+    // Nur in den Ring kopieren (getrimmt) - abgearbeitet wird in bluetooth_update()
+    const char *text = (const char *)characteristic->getData();
+    size_t length = text ? characteristic->getLength() : 0;
+    while (length > 0 && isspace((unsigned char)text[0])) { text++; length--; }
+    while (length > 0 && isspace((unsigned char)text[length - 1])) length--;
+    ble_ring_push(ble_rx_ring, text, length, rx_us);
+    low_power_wake_loop();
   }
 };
 
@@ -269,6 +313,9 @@ void bluetooth_disable() {
 void bluetooth_update() {
   if (!ble_state.enabled) return;
   
+  bluetooth_handle_link_events();
+  bluetooth_process_commands();
+  
   // Update connection display
   if (ble_state.client_connected && ble_overlay) {
     update_ble_overlay_display();
@@ -282,6 +329,58 @@ void bluetooth_update() {
       bluetooth_disconnect_client();
     }
   }
+  
+  ble_flush_responses();
+  if (ble_disconnect_pending && millis() - ble_disconnect_at >= BLE_DISCONNECT_GRACE_MS) {
+    ble_disconnect_pending = false;
+    bluetooth_disconnect_client();
+  }
+}
+
+void bluetooth_handle_link_events() {
+  uint8_t events = __atomic_exchange_n(&ble_link_events, 0, __ATOMIC_ACQUIRE);
+  
+  if (events & BLE_LINK_DISCONNECTED) {
+    DEBUG_PRINTLN("BLE Client disconnected - Device operating independently");
+    hide_ble_overlay();
+    ble_disconnect_pending = false;
+    
+    // Cancel any running remote timers if they were started via BLE
+    if (runtime.state != TIMER_IDLE) {
+      // Let the user decide if they want to cancel - don't auto-cancel
+      DEBUG_PRINTLN("Timer still running - user can cancel manually if needed");
+    }
+  }
+  // Nach kurzem Trennen/Verbinden zählt der aktuelle Zustand
+  if ((events & BLE_LINK_CONNECTED) && ble_state.client_connected) {
+    DEBUG_PRINTLN("BLE Client connected - App can control device remotely");
+    show_ble_overlay();
+    
+    // Send welcome message with device status
+    send_ble_response("OK:CONNECTED:REMOTE_CONTROL_READY");
+  }
+}
+
+void bluetooth_process_commands() {
+  // Pro Runde höchstens einen Ring voll - ein Befehlsschwall hungert die UI nicht aus
+  for (uint8_t i = 0; i < BLE_QUEUE_SIZE; i++) {
+    const BleMessage *message = ble_ring_peek(ble_rx_ring);
+    if (!message) break;
+    
+    ble_command_rx_us = message->rx_us;
+    String command = message->text;
+    ble_ring_pop(ble_rx_ring);
+    
+    DEBUG_PRINTF("BLE Command received: %s\n", command.c_str());
+    process_ble_command(command);
+  }
+  
+  uint32_t dropped = ble_rx_ring.dropped;
+  if (dropped != ble_rx_dropped_reported) {
+    ble_rx_dropped_reported = dropped;
+    DEBUG_PRINTF("WARNING: BLE command queue full - %lu command(s) dropped\n", (unsigned long)dropped);
+    send_ble_response("ERROR:QUEUE_FULL:" + String((unsigned long)dropped));
+  }
 }
 
 void bluetooth_disconnect_client() {
@@ -297,14 +396,16 @@ void bluetooth_disconnect_client() {
 void process_ble_command(String command) {
   if (command.startsWith(BLE_CMD_TIMER_REMOTE)) {
     // Format: TIMER:delay:release:start (e.g., TIMER:5:2:1)
-    int delay, release;
+    int delay;
+    uint32_t release_ms;
     bool start;
-    if (parse_timer_command(command, delay, release, start)) {
+    if (parse_timer_command(command, delay, release_ms, start)) {
+      String release = String(release_ms / 1000) + "." + String((release_ms % 1000) / 100);
       if (start) {
-        start_remote_timer(delay, release);
-        send_ble_response("OK:TIMER_STARTED:" + String(delay) + ":" + String(release));
+        start_remote_timer(delay, release_ms);
+        send_ble_response("OK:TIMER_STARTED:" + String(delay) + ":" + release);
       } else {
-        send_ble_response("OK:TIMER_SET:" + String(delay) + ":" + String(release));
+        send_ble_response("OK:TIMER_SET:" + String(delay) + ":" + release);
       }
     } else {
       send_ble_response("ERROR:INVALID_TIMER_FORMAT");
@@ -316,8 +417,11 @@ void process_ble_command(String command) {
     bool start;
     if (parse_tlapse_command(command, total, frames, start)) {
       if (start) {
-        start_remote_tlapse(total, frames);
-        send_ble_response("OK:TLAPSE_STARTED:" + String(total) + ":" + String(frames));
+        if (start_remote_tlapse(total, frames)) {
+          send_ble_response("OK:TLAPSE_STARTED:" + String(total) + ":" + String(frames));
+        } else {
+          send_ble_response("ERROR:RATE_TOO_HIGH:MAX_FRAMES:" + String(tlapse_max_frames(total)));
+        }
       } else {
         send_ble_response("OK:TLAPSE_SET:" + String(total) + ":" + String(frames));
       }
@@ -331,8 +435,11 @@ void process_ble_command(String command) {
     bool start;
     if (parse_interval_command(command, interval, start)) {
       if (start) {
-        start_remote_interval(interval);
-        send_ble_response("OK:INTERVAL_STARTED:" + String(interval));
+        if (start_remote_interval(interval)) {
+          send_ble_response("OK:INTERVAL_STARTED:" + String(interval));
+        } else {
+          send_ble_response("ERROR:RATE_TOO_HIGH:MIN_MS:" + String(trigger_min_frame_interval_ms()));
+        }
       } else {
         send_ble_response("OK:INTERVAL_SET:" + String(interval));
       }
@@ -342,7 +449,9 @@ void process_ble_command(String command) {
   }
   else if (command == BLE_CMD_SIMPLE_TRIGGER) {
     // Simple immediate trigger - works in any mode
-    servo_activate();
+    trigger_clock_lock();
+    actuator_request(ACTUATOR_SERVO);
+    trigger_clock_unlock();
     send_ble_response("OK:SIMPLE_TRIGGERED");
     DEBUG_PRINTLN("BLE: Simple trigger activated");
   }
@@ -358,17 +467,317 @@ void process_ble_command(String command) {
   else if (command == BLE_CMD_STATUS) {
     send_ble_response(get_device_status());
   }
+  else if (command == BLE_CMD_RATES) {
+    send_ble_response("RATES:" + actuator_rates_string());
+  }
+  else if (command.startsWith(BLE_CMD_FOCUS)) {
+    // Format: FOCUS:every_frame:lead_ms:duration_ms
+    String params = command.substring(6); // Remove "FOCUS:"
+    int first_colon = params.indexOf(':');
+    int second_colon = params.indexOf(':', first_colon + 1);
+    int lead = params.substring(first_colon + 1, second_colon).toInt();
+    int duration = params.substring(second_colon + 1).toInt();
+    if (first_colon == -1 || second_colon == -1 || 
+        lead < 0 || lead > FOCUS_MAX_MS || duration < 0 || duration > FOCUS_MAX_MS) {
+      send_ble_response("ERROR:INVALID_FOCUS_FORMAT");
+      return;
+    }
+    set_focus_config(params.substring(0, first_colon).toInt() == 1, lead, duration);
+    send_ble_response("OK:FOCUS:" + String(app_state.frame_focus ? 1 : 0) + ":" + 
+                      String(app_state.focus_lead_ms) + ":" + String(app_state.focus_duration_ms));
+  }
+  else if (command == BLE_CMD_SYNC) {
+    // Runde starten - Antworten des Masters kommen als SYNC:t1:t2:t3
+    send_ble_response("SYNC_REQ:" + time_sync_int64(time_sync_begin()));
+  }
+  else if (command == "SYNC_STATUS") {
+    send_ble_response("SYNC_STATUS:" + time_sync_status_string());
+  }
+  else if (command == "SYNC_RESET") {
+    time_sync_reset();
+    send_ble_response("OK:SYNC_RESET");
+  }
+  else if (command.startsWith(BLE_CMD_SYNC_AT)) {
+    // Format: SYNC_AT:master_us:mode - alle Geräte lösen zur selben Masterzeit aus
+    String params = command.substring(8);
+    int colon = params.indexOf(':');
+    int64_t master_us = strtoll(params.substring(0, colon == -1 ? params.length() : colon).c_str(), nullptr, 10);
+    char mode = colon == -1 ? ' ' : toupper(params.charAt(colon + 1));
+    if (master_us <= 0 || (mode != 'T' && mode != 'L' && mode != 'I')) {
+      send_ble_response("ERROR:INVALID_SYNC_AT_FORMAT");
+    } else if (!time_sync_valid()) {
+      send_ble_response("ERROR:NOT_SYNCED");
+    } else if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (time_sync_start_at(master_us, mode == 'T' ? TIMER_EXEC_MODE : 
+                                  mode == 'I' ? INTERVAL_EXEC_MODE : TLAPSE_EXEC_MODE)) {
+      send_ble_response("OK:START_ARMED:" + String((unsigned long)US_TO_MS(runtime.startTime - trigger_clock_now_us())));
+    } else {
+      send_ble_response("ERROR:START_AT_REJECTED");
+    }
+  }
+  else if (command.startsWith("SYNC:")) {
+    // Format: SYNC:t1:t2:t3 - t1 aus SYNC_REQ zurück, t2/t3 Masterzeit in µs
+    String params = command.substring(5);
+    int first_colon = params.indexOf(':');
+    int second_colon = params.indexOf(':', first_colon + 1);
+    if (first_colon == -1 || second_colon == -1) {
+      send_ble_response("ERROR:INVALID_SYNC_FORMAT");
+      return;
+    }
+    uint64_t t1 = strtoull(params.substring(0, first_colon).c_str(), nullptr, 10);
+    int64_t t2 = strtoll(params.substring(first_colon + 1, second_colon).c_str(), nullptr, 10);
+    int64_t t3 = strtoll(params.substring(second_colon + 1).c_str(), nullptr, 10);
+    switch (time_sync_sample(t1, t2, t3, ble_command_rx_us)) {
+      case TIMESYNC_NEXT:
+        send_ble_response("SYNC_REQ:" + time_sync_int64(time_sync_next_request()));
+        break;
+      case TIMESYNC_DONE:
+        send_ble_response("OK:SYNCED:" + time_sync_status_string());
+        break;
+      default:
+        send_ble_response("ERROR:SYNC_REJECTED");
+        break;
+    }
+  }
+  else if (command == BLE_CMD_OUTPUTS) {
+    send_ble_response("OUTPUTS:" + outputs_string());
+  }
+  else if (command.startsWith("OUTPUT:")) {
+    // Format: OUTPUT:n:type:pin:focus:offset_ms:width_ms
+    String fields[6];
+    String params = command.substring(7);
+    uint8_t count = 0;
+    while (count < 6) {
+      int colon = params.indexOf(':');
+      fields[count++] = colon == -1 ? params : params.substring(0, colon);
+      if (colon == -1) break;
+      params = params.substring(colon + 1);
+    }
+    if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (count == 6 && fields[1].length() == 1 &&
+               output_configure(fields[0].toInt(), fields[1][0], fields[2].toInt(), fields[3].toInt(),
+                                fields[4].toInt(), fields[5].toInt())) {
+      send_ble_response("OUTPUTS:" + outputs_string());
+    } else {
+      send_ble_response("ERROR:INVALID_OUTPUT_FORMAT");
+    }
+  }
+  else if (command == BLE_CMD_EXT) {
+    send_ble_response("EXT:" + ext_trigger_status_string());
+  }
+  else if (command == "EXT:ARM") {
+    if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (launch_external_trigger()) {
+      send_ble_response("OK:EXT_ARMED");
+    } else {
+      send_ble_response("ERROR:EXT_NOT_ARMED");
+    }
+  }
+  else if (command == "EXT:FIRE") {
+    send_ble_response(ext_trigger_simulate() ? "OK:EXT_FIRED" : "ERROR:EXT_NOT_READY");
+  }
+  else if (command.startsWith("EXT:")) {
+    // Format: EXT:delay_ms:lockout_ms:servo
+    String params = command.substring(4);
+    int first_colon = params.indexOf(':');
+    int second_colon = params.indexOf(':', first_colon + 1);
+    int delay_ms = params.substring(0, first_colon).toInt();
+    int lockout_ms = params.substring(first_colon + 1, second_colon).toInt();
+    if (first_colon == -1 || second_colon == -1 || !ext_trigger_config_valid(delay_ms, lockout_ms)) {
+      send_ble_response("ERROR:INVALID_EXT_FORMAT");
+    } else {
+      // Gilt ab dem nächsten Scharfschalten
+      set_ext_trigger_config(delay_ms, lockout_ms, params.substring(second_colon + 1).toInt() == 1);
+      send_ble_response("EXT:" + ext_trigger_status_string());
+    }
+  }
+  else if (command == BLE_CMD_LAG) {
+    send_ble_response("LAG:" + lag_profiles_string());
+  }
+  else if (command.startsWith("LAG:USE:")) {
+    if (lag_profile_select(command.substring(8).toInt())) {
+      send_ble_response("LAG:" + lag_profiles_string());
+    } else {
+      send_ble_response("ERROR:INVALID_LAG_PROFILE");
+    }
+  }
+  else if (command.startsWith("LAG:SET:")) {
+    // Format: LAG:SET:index:lag_ms:name (name optional)
+    String params = command.substring(8);
+    int first_colon = params.indexOf(':');
+    int second_colon = params.indexOf(':', first_colon + 1);
+    String name = second_colon == -1 ? "" : params.substring(second_colon + 1);
+    int lag = params.substring(first_colon + 1, second_colon == -1 ? params.length() : second_colon).toInt();
+    if (first_colon != -1 && lag_profile_set(params.substring(0, first_colon).toInt(), name, lag)) {
+      send_ble_response("LAG:" + lag_profiles_string());
+    } else {
+      send_ble_response("ERROR:INVALID_LAG_FORMAT");
+    }
+  }
+  else if (command == "LAG:MEASURE") {
+    // Ergebnis folgt asynchron als OK:LAG_MEASURED:<ms> bzw. ERROR:LAG_TIMEOUT
+    if (lag_measure_start()) {
+      send_ble_response("OK:LAG_MEASURING");
+    } else {
+      send_ble_response("ERROR:BUSY");
+    }
+  }
+  else if (command == BLE_CMD_POWER) {
+    send_ble_response("POWER:" + low_power_status_string());
+  }
+  else if (command.startsWith("POWER:DEEP:")) {
+    set_deep_sleep(command.substring(11).toInt() == 1);
+    send_ble_response("POWER:" + low_power_status_string());
+  }
+  else if (command.startsWith("POWER:")) {
+    set_low_power(command.substring(6).toInt() == 1);
+    send_ble_response("POWER:" + low_power_status_string());
+  }
+  else if (command == BLE_CMD_CLOCK) {
+    send_ble_response("CLOCK:" + wall_clock_status_string());
+  }
+  else if (command.startsWith("CLOCK:")) {
+    // Format: CLOCK:epoch_ms:tz_min - Handy-Zeit, jeder Sync verfeinert die RTC-Drift
+    String params = command.substring(6);
+    int colon = params.indexOf(':');
+    int64_t epoch_ms = strtoll(params.substring(0, colon == -1 ? params.length() : colon).c_str(), nullptr, 10);
+    long tz_min = colon == -1 ? 0 : params.substring(colon + 1).toInt();
+    if (epoch_ms <= 0 || tz_min < -14 * 60 || tz_min > 14 * 60) {
+      send_ble_response("ERROR:INVALID_CLOCK_FORMAT");
+      return;
+    }
+    wall_clock_set(epoch_ms * 1000, tz_min * 60);
+    send_ble_response("CLOCK:" + wall_clock_status_string());
+  }
+  else if (command.startsWith(BLE_CMD_START_AT)) {
+    // Format: START_AT:epoch_s:mode - Werte der jeweiligen Seite, Start zur Uhrzeit
+    String params = command.substring(9);
+    int colon = params.indexOf(':');
+    int64_t epoch_s = strtoll(params.substring(0, colon == -1 ? params.length() : colon).c_str(), nullptr, 10);
+    char mode = colon == -1 ? ' ' : toupper(params.charAt(colon + 1));
+    if (epoch_s <= 0 || (mode != 'T' && mode != 'L' && mode != 'I')) {
+      send_ble_response("ERROR:INVALID_START_AT_FORMAT");
+    } else if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (wall_clock_start_at(epoch_s * 1000000, mode == 'T' ? TIMER_EXEC_MODE : 
+                                   mode == 'I' ? INTERVAL_EXEC_MODE : TLAPSE_EXEC_MODE)) {
+      send_ble_response("OK:START_ARMED:" + String((unsigned long)((runtime.startTime - trigger_clock_now_us()) / 1000000)));
+    } else {
+      send_ble_response("ERROR:START_AT_REJECTED");
+    }
+  }
+  else if (command == BLE_CMD_PAUSE) {
+    if (pause_execution()) {
+      send_ble_response("OK:PAUSED:" + String(runtime.frameCount));
+    } else {
+      send_ble_response("ERROR:NOT_PAUSABLE");
+    }
+  }
+  else if (command == BLE_CMD_RESUME || command == "RESUME:GRID" || command == "RESUME:SHIFT") {
+    bool shift = command == BLE_CMD_RESUME ? app_state.resume_shift : command == "RESUME:SHIFT";
+    if (resume_execution(shift)) {
+      send_ble_response("OK:RESUMED:" + String(shift ? "SHIFT:" : "GRID:") + String(runtime.pausedFrames));
+    } else {
+      send_ble_response("ERROR:NOT_PAUSED");
+    }
+  }
+  else if (command == "RESUME_MODE:GRID" || command == "RESUME_MODE:SHIFT") {
+    set_resume_shift(command.endsWith("SHIFT"));
+    send_ble_response("OK:RESUME_MODE:" + String(app_state.resume_shift ? "SHIFT" : "GRID"));
+  }
+  else if (command == BLE_CMD_RAMP) {
+    send_ble_response("RAMP:" + String("LIOS"[app_state.ramp_curve]) + ":" + ramp_plan_string(tlapse_ramp));
+  }
+  else if (command.startsWith("RAMP:")) {
+    // Format: RAMP:curve[:keyframes:start] - curve L/I/O/S, keyframes <s>@<ms>,...
+    String params = command.substring(5);
+    int first_colon = params.indexOf(':');
+    int curve = ramp_curve_from_char(params.charAt(0));
+    if (curve < 0 || (first_colon != -1 && first_colon != 1)) {
+      send_ble_response("ERROR:INVALID_RAMP_FORMAT");
+      return;
+    }
+    set_ramp_curve(curve);
+    if (first_colon == -1) {
+      send_ble_response("OK:RAMP_CURVE:" + String(ramp_curve_name(curve)));
+      return;
+    }
+    
+    int second_colon = params.indexOf(':', first_colon + 1);
+    RampPlan plan;
+    plan.curve = curve;
+    if (!ramp_parse(params.substring(first_colon + 1, second_colon == -1 ? params.length() : second_colon), plan)) {
+      send_ble_response("ERROR:INVALID_RAMP_FORMAT");
+    } else if (second_colon == -1 || params.substring(second_colon + 1).toInt() != 1) {
+      tlapse_ramp = plan;
+      send_ble_response("OK:RAMP_SET:" + ramp_plan_string(plan));
+    } else if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (launch_tlapse_ramp(plan)) {
+      send_ble_response("OK:RAMP_STARTED:" + String(runtime.totalFrames));
+    } else {
+      send_ble_response("ERROR:RATE_TOO_HIGH:MIN_MS:" + String(trigger_min_frame_interval_ms()));
+    }
+  }
+  else if (command.startsWith(BLE_CMD_BURST)) {
+    // Format: BURST:count:rate_hz:pulse_ms:start (e.g., BURST:10:20:20:1)
+    int count, rate, pulse;
+    bool start;
+    if (parse_burst_command(command, count, rate, pulse, start)) {
+      set_burst_config(count, rate, pulse);
+      String params = String(count) + ":" + String(rate) + ":" + String(pulse);
+      if (!start) {
+        send_ble_response("OK:BURST_SET:" + params);
+      } else if (runtime.state != TIMER_IDLE) {
+        send_ble_response("ERROR:BUSY");
+      } else if (launch_burst_execution(count, rate, pulse)) {
+        send_ble_response("OK:BURST_STARTED:" + params);
+      } else {
+        send_ble_response("ERROR:BURST_NOT_STARTED");
+      }
+    } else {
+      send_ble_response("ERROR:INVALID_BURST_FORMAT");
+    }
+  }
+  else if (command.startsWith(BLE_CMD_SEQUENCE)) {
+    if (runtime.state != TIMER_IDLE) {
+      send_ble_response("ERROR:BUSY");
+    } else if (launch_sequence_execution(command.substring(4))) {
+      uint32_t frames = sequence_total_frames(sequence_program);
+      send_ble_response("OK:SEQ_STARTED:" + String(frames));   // 0 = endlos
+    } else {
+      send_ble_response("ERROR:INVALID_SEQUENCE");
+    }
+  }
+  else if (command.startsWith(BLE_CMD_CATCHUP)) {
+    String policy = command.substring(8); // Remove "CATCHUP:"
+    if (policy == "SKIP") {
+      set_catchup_policy(CATCHUP_SKIP);
+    } else if (policy == "FIRE") {
+      set_catchup_policy(CATCHUP_FIRE_NOW);
+    } else if (policy == "SHIFT") {
+      set_catchup_policy(CATCHUP_SHIFT);
+    } else {
+      send_ble_response("ERROR:INVALID_CATCHUP_POLICY");
+      return;
+    }
+    send_ble_response("OK:CATCHUP:" + String(catchup_policy_name(app_state.catchup_policy)));
+  }
   else if (command == BLE_CMD_DISCONNECT) {
+    // Trennen erst, wenn die Antwort raus ist (bluetooth_update)
     send_ble_response("OK:DISCONNECTING");
-    delay(100); // Give time for response to send
-    bluetooth_disconnect_client();
+    ble_disconnect_pending = true;
+    ble_disconnect_at = millis();
   }
   else {
     send_ble_response("ERROR:UNKNOWN_COMMAND:" + command);
   }
 }
 
-bool parse_timer_command(String command, int &delay, int &release, bool &start) {
+bool parse_timer_command(String command, int &delay, uint32_t &release_ms, bool &start) {
   // Format: TIMER:delay:release:start
   String params = command.substring(6); // Remove "TIMER:"
   
@@ -378,11 +787,15 @@ bool parse_timer_command(String command, int &delay, int &release, bool &start)
   if (first_colon == -1 || second_colon == -1) return false;
   
   delay = params.substring(0, first_colon).toInt();
-  release = params.substring(first_colon + 1, second_colon).toInt();
+  // Release in Sekunden, Zehntel erlaubt ("2.5") - ganzzahlig auf 100 ms gerundet
+  float release = params.substring(first_colon + 1, second_colon).toFloat();
   start = params.substring(second_colon + 1).toInt() == 1;
   
+  if (release < 0) return false;
+  release_ms = (uint32_t)(release * 10 + 0.5f) * 100;
+  
   // Validate ranges
-  if (delay < 0 || delay > 3599 || release < 0 || release > 3599) return false;
+  if (delay < 0 || delay > VALUE_MAX_DURATION_S || release_ms > VALUE_MAX_MS) return false;
   
   return true;
 }
@@ -401,7 +814,7 @@ bool parse_tlapse_command(String command, int &total, int &frames, bool &start)
   start = params.substring(second_colon + 1).toInt() == 1;
   
   // Validate ranges and logic
-  if (total < 1 || total > 3599 || frames < 0 || frames > total) return false;
+  if (total < 1 || total > VALUE_MAX_DURATION_S || frames < 0 || frames > total) return false;
   
   return true;
 }
@@ -417,72 +830,71 @@ bool parse_interval_command(String command, int &interval, bool &start) {
   start = params.substring(colon + 1).toInt() == 1;
   
   // Validate range
-  if (interval < 1 || interval > 3599) return false;
+  if (interval < 1 || interval > VALUE_MAX_DURATION_S) return false;
   
   return true;
 }
 
-void start_remote_timer(int delay, int release) {
-  DEBUG_PRINTF("Starting remote timer: %ds delay, %ds release\n", delay, release);
+bool parse_burst_command(String command, int &count, int &rate, int &pulse, bool &start) {
+  // Format: BURST:count:rate_hz:pulse_ms:start
+  String params = command.substring(6); // Remove "BURST:"
+  
+  int first_colon = params.indexOf(':');
+  int second_colon = params.indexOf(':', first_colon + 1);
+  int third_colon = params.indexOf(':', second_colon + 1);
+  
+  if (first_colon == -1 || second_colon == -1 || third_colon == -1) return false;
+  
+  count = params.substring(0, first_colon).toInt();
+  rate = params.substring(first_colon + 1, second_colon).toInt();
+  pulse = params.substring(second_colon + 1, third_colon).toInt();
+  start = params.substring(third_colon + 1).toInt() == 1;
+  
+  // Validate ranges (Rate, Pulsbreite und Lücke zusammen)
+  return burst_config_valid(count, rate, pulse);
+}
+
+void start_remote_timer(int delay, uint32_t release_ms) {
+  DEBUG_PRINTF("Starting remote timer: %ds delay, %lums release\n", delay, (unsigned long)release_ms);
   
   // Set up runtime with app values (not device values)
-  runtime.totalDelayTime = delay;
-  runtime.totalReleaseTime = release;
-  runtime.mode = TIMER_EXEC_MODE;
-  runtime.state = TIMER_DELAY_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
-  
-  servo_move_to_position(servoStartPosition);
-  show_timer_overlay();
+  launch_timer_execution(delay, release_ms);
 }
 
-void start_remote_tlapse(int total, int frames) {
+bool start_remote_tlapse(int total, int frames) {
   DEBUG_PRINTF("Starting remote T-Lapse: %ds total, %d frames\n", total, frames);
   
   // Set up runtime with app values
-  runtime.totalTime = total;
-  runtime.totalFrames = frames;
-  runtime.mode = TLAPSE_EXEC_MODE;
-  runtime.state = TLAPSE_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
-  
-  if (frames > 0) {
-    runtime.frameInterval = (float)total / frames;
-  } else {
-    runtime.frameInterval = 1.0;
-  }
-  
-  servo_move_to_position(servoStartPosition);
-  show_tlapse_overlay();
+  return launch_tlapse_execution(total, frames);
 }
 
-void start_remote_interval(int interval) {
+bool start_remote_interval(int interval) {
   DEBUG_PRINTF("Starting remote Interval: %ds interval\n", interval);
   
   // Set up runtime with app values
-  runtime.intervalTime = interval;
-  runtime.mode = INTERVAL_EXEC_MODE;
-  runtime.state = INTERVAL_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
-  
-  servo_move_to_position(servoStartPosition);
-  show_interval_overlay();
+  return launch_interval_execution(interval);
 }
 
 void send_ble_response(String response) {
-  if (ble_characteristic && ble_state.client_connected) {
-    ble_characteristic->setValue(response.c_str());
-    ble_characteristic->notify();
-    DEBUG_PRINTF("BLE Response sent: %s\n", response.c_str());
+  if (!ble_characteristic || !ble_state.client_connected) return;
+  
+  // Produzent und Konsument sind beide die Loop - bei vollem Ring erst verschicken
+  if (ble_ring_count(ble_tx_ring) >= BLE_QUEUE_SIZE) ble_flush_responses();
+  if (response.length() > BLE_MESSAGE_MAX_LEN) {
+    DEBUG_PRINTF("WARNING: BLE response truncated to %d bytes\n", BLE_MESSAGE_MAX_LEN);
+  }
+  ble_ring_push(ble_tx_ring, response.c_str(), response.length(), 0);
+}
+
+void ble_flush_responses() {
+  const BleMessage *message;
+  while ((message = ble_ring_peek(ble_tx_ring)) != nullptr) {
+    if (ble_characteristic && ble_state.client_connected) {
+      ble_characteristic->setValue((uint8_t *)message->text, message->length);
+      ble_characteristic->notify();
+      DEBUG_PRINTF("BLE Response sent: %s\n", message->text);
+    }
+    ble_ring_pop(ble_tx_ring);
   }
 }
 
@@ -496,6 +908,7 @@ String get_device_status() {
     case STATE_TLAPSE: status += "TLAPSE"; break;
     case STATE_INTERVAL: status += "INTERVAL"; break;
     case STATE_SETTINGS: status += "SETTINGS"; break;
+    case STATE_BURST: status += "BURST"; break;
     default: status += "UNKNOWN"; break;
   }
   
@@ -507,9 +920,23 @@ String get_device_status() {
     case TIMER_RELEASE_RUNNING: status += "RELEASE"; break;
     case TLAPSE_RUNNING: status += "TLAPSE"; break;
     case INTERVAL_RUNNING: status += "INTERVAL"; break;
+    case SEQUENCE_RUNNING: status += "SEQUENCE"; break;
+    case BURST_RUNNING: status += "BURST"; break;
+    case EXTERNAL_ARMED: status += "EXTERNAL"; break;
     default: status += "UNKNOWN"; break;
   }
   
+  // Frame-Statistik des laufenden bzw. letzten Laufs
+  status += ",FRAMES:" + String(runtime.frameCount);
+  status += ",MISSED:" + String(runtime.missedFrames);
+  status += ",LATE:" + String(runtime.lateFrames);
+  if (runtime.paused) {
+    status += ",PAUSED:" + String(runtime.pausedFrames);
+  }
+  if (timer_run_armed()) {
+    status += ",ARMED:" + String((unsigned long)((runtime.startTime - trigger_clock_now_us()) / 1000000));
+  }
+  
   return status;
 }
 
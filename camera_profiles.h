@@ -0,0 +1,146 @@
+/*
+=============================================================================
+camera_profiles.h - Kamera-Profile mit gemessenem Shutter-Lag
+=============================================================================
+Jede Kamera belichtet erst 50-300 ms nach dem Release-Signal. Das aktive
+Profil liefert diesen Lag - der Sequence-Executor löst jeden Frame um genau
+diese Zeit früher aus, damit die Belichtung auf dem geplanten Raster liegt.
+Die Profile liegen in einem eigenen NVS-Namespace (unabhängig von
+SETTINGS_VERSION).
+=============================================================================
+*/
+
+#ifndef CAMERA_PROFILES_H
+#define CAMERA_PROFILES_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "config.h"
+
+// =============================================================================
+// PROFILE CONFIGURATION
+// =============================================================================
+#define LAG_NAMESPACE         "camera_lag"
+#define LAG_PROFILE_COUNT     4
+#define LAG_PROFILE_NAME_LEN  12
+#define LAG_MAX_MS            1000
+#define LAG_STORE_VERSION     1
+
+struct LagProfile {
+  char name[LAG_PROFILE_NAME_LEN];
+  uint16_t lag_ms;          // Release-Signal -> Belichtungsbeginn
+};
+
+struct LagProfileStore {
+  uint8_t version;
+  uint8_t active;           // Index des aktiven Profils
+  LagProfile profiles[LAG_PROFILE_COUNT];
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void lag_profiles_init();
+void lag_profiles_defaults();
+void lag_profiles_save();
+uint16_t active_shutter_lag_ms();
+bool lag_profile_select(int index);
+bool lag_profile_set(int index, String name, int lag_ms);
+String lag_profiles_string();       // BLE: LAG:<active>:<i>:<name>:<ms>,...
+void print_lag_profiles();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+LagProfileStore lag_profiles;
+
+void lag_profiles_defaults() {
+  lag_profiles.version = LAG_STORE_VERSION;
+  lag_profiles.active = 0;
+  for (uint8_t i = 0; i < LAG_PROFILE_COUNT; i++) {
+    snprintf(lag_profiles.profiles[i].name, LAG_PROFILE_NAME_LEN, i == 0 ? "Default" : "Camera %d", i);
+    lag_profiles.profiles[i].lag_ms = 0;
+  }
+}
+
+void lag_profiles_init() {
+  lag_profiles_defaults();
+
+  Preferences prefs;
+  if (!prefs.begin(LAG_NAMESPACE, true)) {
+    DEBUG_PRINTLN("Camera profiles: no stored profiles - using defaults");
+    return;
+  }
+
+  LagProfileStore stored;
+  size_t read = prefs.getBytes("profiles", &stored, sizeof(stored));
+  prefs.end();
+
+  if (read == sizeof(stored) && stored.version == LAG_STORE_VERSION && stored.active < LAG_PROFILE_COUNT) {
+    lag_profiles = stored;
+    for (uint8_t i = 0; i < LAG_PROFILE_COUNT; i++) {
+      lag_profiles.profiles[i].name[LAG_PROFILE_NAME_LEN - 1] = '\0';
+    }
+  }
+
+  DEBUG_PRINTF("Camera profiles loaded - active: %s (%d ms lag)\n",
+               lag_profiles.profiles[lag_profiles.active].name, active_shutter_lag_ms());
+}
+
+void lag_profiles_save() {
+  Preferences prefs;
+  if (!prefs.begin(LAG_NAMESPACE, false)) {
+    DEBUG_PRINTLN("ERROR: Failed to open camera profiles for writing");
+    return;
+  }
+  prefs.putBytes("profiles", &lag_profiles, sizeof(lag_profiles));
+  prefs.end();
+}
+
+uint16_t active_shutter_lag_ms() {
+  return lag_profiles.profiles[lag_profiles.active].lag_ms;
+}
+
+bool lag_profile_select(int index) {
+  if (index < 0 || index >= LAG_PROFILE_COUNT) return false;
+  lag_profiles.active = index;
+  lag_profiles_save();
+  DEBUG_PRINTF("Camera profile %d active: %s (%d ms lag)\n", index,
+               lag_profiles.profiles[index].name, lag_profiles.profiles[index].lag_ms);
+  return true;
+}
+
+bool lag_profile_set(int index, String name, int lag_ms) {
+  if (index < 0 || index >= LAG_PROFILE_COUNT || lag_ms < 0 || lag_ms > LAG_MAX_MS) return false;
+
+  LagProfile &profile = lag_profiles.profiles[index];
+  name.trim();
+  if (name.length() > 0) {
+    strncpy(profile.name, name.c_str(), LAG_PROFILE_NAME_LEN - 1);
+    profile.name[LAG_PROFILE_NAME_LEN - 1] = '\0';
+  }
+  profile.lag_ms = lag_ms;
+  lag_profiles_save();
+  DEBUG_PRINTF("Camera profile %d set: %s (%d ms lag)\n", index, profile.name, profile.lag_ms);
+  return true;
+}
+
+String lag_profiles_string() {
+  String result = String(lag_profiles.active);
+  for (uint8_t i = 0; i < LAG_PROFILE_COUNT; i++) {
+    result += (i == 0 ? ":" : ",") + String(i) + ":" + lag_profiles.profiles[i].name + ":" +
+              String(lag_profiles.profiles[i].lag_ms);
+  }
+  return result;
+}
+
+void print_lag_profiles() {
+  Serial.println("=== Camera Profiles (shutter lag) ===");
+  for (uint8_t i = 0; i < LAG_PROFILE_COUNT; i++) {
+    Serial.printf("%c %d: %-11s %4d ms\n", i == lag_profiles.active ? '*' : ' ', i,
+                  lag_profiles.profiles[i].name, lag_profiles.profiles[i].lag_ms);
+  }
+  Serial.println("=====================================");
+}
+
+#endif // CAMERA_PROFILES_H
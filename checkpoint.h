@@ -0,0 +1,306 @@
+/*
+=============================================================================
+checkpoint.h - Lauf-Checkpoints für Resume nach Brownout/Watchdog
+=============================================================================
+Ein Reset mitten im Lauf (Servo-Stromspitze -> Brownout, Watchdog, Panic)
+verliert sonst runtime, und die Aufnahme hört stillschweigend auf.
+  - Beim Start eines Laufs: Parameter + kompiliertes Programm einmal ins NVS.
+  - Nach jedem Frame: Position im Programm in den RTC-Speicher (nur RAM).
+  - Alle CHECKPOINT_EVERY_FRAMES Frames, frühestens nach
+    CHECKPOINT_MIN_INTERVAL_MS: dieselbe Position ins NVS (ein Blob-Write).
+Beim Boot setzt checkpoint_resume() den Lauf auf dem ursprünglichen Raster
+fort - die RTC-Zeit überbrückt den Reset, verpasste Frames entscheidet die
+Catch-up-Policy. Nach einem Power-On-Reset (Schalter aus, Akku leer) ist die
+Zeit unbekannt - dann wird nicht fortgesetzt.
+=============================================================================
+*/
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stddef.h>
+#include "config.h"
+#include "trigger_clock.h"
+#include "checksum.h"
+#include "sequence.h"
+
+#if defined(ESP32)
+#include "esp_system.h"
+#endif
+
+// =============================================================================
+// CHECKPOINT CONFIGURATION
+// =============================================================================
+#define CHECKPOINT_NAMESPACE  "checkpoint"
+#define CHECKPOINT_VERSION    1
+#define CHECKPOINT_MAGIC      0x52534350   // "RSCP"
+
+// Einmal pro Lauf - alles, was sich während des Laufs nicht ändert
+struct CheckpointRun {
+  uint8_t version;
+  TimerRuntime runtime;       // Zustand beim Start (Modus, Parameter, Startzeit, Lag)
+  SequenceCode code;
+};
+
+// Nach jedem Frame (RTC) bzw. alle N Frames (NVS) - Position im Programm
+struct CheckpointPos {
+  uint32_t magic;
+  uint32_t checksum;          // FNV-1a ab run_start
+  uint64_t run_start;         // runtime.startTime - ordnet die Position dem Lauf zu
+  uint64_t clock_us;          // trigger_clock_now_us() beim Checkpoint
+  uint64_t rtc_us;            // trigger_clock_rtc_us() beim Checkpoint
+  SequenceVM vm;
+  SequenceAction next;
+  int frameCount;
+  int missedFrames;
+  int lateFrames;
+  uint64_t scheduleShift;
+  bool paused;                // Pause überlebt den Reset - erst Resume plant weiter
+  uint64_t pausedAt;
+  uint64_t pausedTotal;
+  int pausedFrames;
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+bool checkpoint_resume();           // Nach settings_init(): true wenn ein Lauf fortgesetzt wird
+void checkpoint_update();           // Aus app_loop() - schreibt nur bei Fortschritt
+void checkpoint_clear();
+bool checkpoint_run_eligible();
+void print_checkpoint_status();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+RTC_NOINIT_ATTR CheckpointPos checkpoint_rtc;      // Nicht initialisiert - überlebt auch Watchdog/Panic
+CheckpointRun checkpoint_run;                      // Puffer für NVS (zu groß für den Stack)
+
+// Überleben den Deep-Sleep - sonst schriebe jeder Wake den Lauf neu ins NVS
+RTC_DATA_ATTR bool checkpoint_active = false;
+RTC_DATA_ATTR uint64_t checkpoint_run_start = 0;
+RTC_DATA_ATTR int checkpoint_saved_frame = 0;      // Stand des letzten NVS-Writes
+RTC_DATA_ATTR uint64_t checkpoint_saved_us = 0;    // Trigger-Zeitbasis des letzten NVS-Writes
+uint32_t checkpoint_writes = 0;                    // NVS-Writes seit Boot
+
+uint32_t checkpoint_checksum(const CheckpointPos &pos) {
+  return fnv1a(&pos.run_start, sizeof(pos) - offsetof(CheckpointPos, run_start));
+}
+
+bool checkpoint_pos_valid(const CheckpointPos &pos, uint64_t run_start) {
+  return pos.magic == CHECKPOINT_MAGIC && pos.run_start == run_start && 
+         pos.checksum == checkpoint_checksum(pos);
+}
+
+bool checkpoint_run_eligible() {
+  // Burst dauert Sekunden, externer Trigger hat keinen Plan - kein Checkpoint
+  return runtime.state != TIMER_IDLE && !runtime.logic_completed && 
+         runtime.mode != BURST_EXEC_MODE && runtime.mode != EXTERNAL_EXEC_MODE;
+}
+
+TimerExecutionState checkpoint_base_state(TimerExecutionMode mode) {
+  switch (mode) {
+    case TIMER_EXEC_MODE:  return TIMER_DELAY_RUNNING;
+    case TLAPSE_EXEC_MODE: return TLAPSE_RUNNING;
+    case INTERVAL_EXEC_MODE: return INTERVAL_RUNNING;
+    default:               return SEQUENCE_RUNNING;
+  }
+}
+
+void checkpoint_capture(CheckpointPos &pos) {
+  // Aufrufer hält trigger_clock_lock()
+  pos.run_start = runtime.startTime;
+  pos.clock_us = trigger_clock_now_us();
+  pos.rtc_us = trigger_clock_rtc_us();
+  pos.vm = runtime.sequenceVM;
+  pos.next = runtime.nextAction;
+  pos.frameCount = runtime.frameCount;
+  pos.missedFrames = runtime.missedFrames;
+  pos.lateFrames = runtime.lateFrames;
+  pos.scheduleShift = runtime.scheduleShift;
+  pos.paused = runtime.paused;
+  pos.pausedAt = runtime.pausedAt;
+  pos.pausedTotal = runtime.pausedTotal;
+  pos.pausedFrames = runtime.pausedFrames;
+  pos.checksum = checkpoint_checksum(pos);
+  pos.magic = CHECKPOINT_MAGIC;
+}
+
+void checkpoint_save_pos() {
+  Preferences prefs;
+  if (!prefs.begin(CHECKPOINT_NAMESPACE, false)) {
+    DEBUG_PRINTLN("ERROR: Failed to open checkpoint storage for writing");
+    return;
+  }
+  prefs.putBytes("pos", &checkpoint_rtc, sizeof(checkpoint_rtc));
+  prefs.end();
+  
+  checkpoint_saved_frame = checkpoint_rtc.frameCount;
+  checkpoint_saved_us = checkpoint_rtc.clock_us;
+  checkpoint_writes++;
+}
+
+void checkpoint_begin_run() {
+  trigger_clock_lock();
+  checkpoint_run.version = CHECKPOINT_VERSION;
+  checkpoint_run.runtime = runtime;
+  checkpoint_run.runtime.state = checkpoint_base_state(runtime.mode);
+  checkpoint_run.code = sequence_code;
+  checkpoint_capture(checkpoint_rtc);
+  trigger_clock_unlock();
+  
+  Preferences prefs;
+  if (!prefs.begin(CHECKPOINT_NAMESPACE, false)) {
+    DEBUG_PRINTLN("ERROR: Failed to open checkpoint storage for writing");
+    return;
+  }
+  prefs.putBytes("run", &checkpoint_run, sizeof(checkpoint_run));
+  prefs.end();
+  
+  checkpoint_active = true;
+  checkpoint_run_start = checkpoint_rtc.run_start;
+  checkpoint_save_pos();
+  DEBUG_PRINTF("Checkpoint: run recorded (%d ops, NVS every %d frames)\n", 
+               sequence_code.count, CHECKPOINT_EVERY_FRAMES);
+}
+
+void checkpoint_clear() {
+  checkpoint_rtc.magic = 0;
+  checkpoint_active = false;
+  
+  Preferences prefs;
+  if (prefs.begin(CHECKPOINT_NAMESPACE, false)) {
+    prefs.clear();
+    prefs.end();
+  }
+  DEBUG_PRINTLN("Checkpoint cleared");
+}
+
+void checkpoint_update() {
+  trigger_clock_lock();
+  bool eligible = checkpoint_run_eligible();
+  uint64_t run_start = runtime.startTime;
+  bool progressed = runtime.frameCount != checkpoint_rtc.frameCount || 
+                    runtime.missedFrames != checkpoint_rtc.missedFrames ||
+                    runtime.paused != checkpoint_rtc.paused;
+  trigger_clock_unlock();
+  
+  if (!eligible) {
+    // Lauf fertig oder abgebrochen - nichts fortzusetzen
+    if (checkpoint_active) checkpoint_clear();
+    return;
+  }
+  if (!checkpoint_active || run_start != checkpoint_run_start) {
+    checkpoint_begin_run();
+    return;
+  }
+  if (!progressed) return;
+  
+  // RTC-Kopie kostet nur ein memcpy - NVS begrenzt auf alle N Frames
+  trigger_clock_lock();
+  checkpoint_capture(checkpoint_rtc);
+  trigger_clock_unlock();
+  
+  if (checkpoint_rtc.frameCount - checkpoint_saved_frame >= CHECKPOINT_EVERY_FRAMES &&
+      checkpoint_rtc.clock_us - checkpoint_saved_us >= MS_TO_US(CHECKPOINT_MIN_INTERVAL_MS)) {
+    checkpoint_save_pos();
+  }
+}
+
+bool checkpoint_resume() {
+  Preferences prefs;
+  if (!prefs.begin(CHECKPOINT_NAMESPACE, true)) return false;
+  size_t run_read = prefs.getBytes("run", &checkpoint_run, sizeof(checkpoint_run));
+  CheckpointPos pos;
+  size_t pos_read = prefs.getBytes("pos", &pos, sizeof(pos));
+  prefs.end();
+  
+  if (run_read != sizeof(checkpoint_run) || checkpoint_run.version != CHECKPOINT_VERSION) return false;
+  
+  // Jüngere der beiden Positionen - RTC überlebt Watchdog/Panic, NVS auch den Brownout
+  uint64_t run_start = checkpoint_run.runtime.startTime;
+  bool nvs_valid = pos_read == sizeof(pos) && checkpoint_pos_valid(pos, run_start);
+  bool rtc_valid = checkpoint_pos_valid(checkpoint_rtc, run_start);
+  if (rtc_valid && (!nvs_valid || checkpoint_rtc.frameCount >= pos.frameCount)) {
+    pos = checkpoint_rtc;
+  } else if (!nvs_valid) {
+    return false;
+  }
+  
+#if defined(ESP32)
+  if (esp_reset_reason() == ESP_RST_POWERON) {
+    // Ausgeschaltet oder Akku leer - Ausfallzeit unbekannt, Lauf nicht wieder aufnehmen
+    DEBUG_PRINTF("Checkpoint of interrupted run (frame %d) dropped - power-on reset\n", pos.frameCount);
+    checkpoint_clear();
+    return false;
+  }
+#endif
+  
+  // Zeitbasis um die Ausfallzeit fortsetzen - das Raster bleibt das des Starts
+  uint64_t rtc_now = trigger_clock_rtc_us();
+  bool grid_known = rtc_now >= pos.rtc_us;
+  uint64_t offline_us = grid_known ? rtc_now - pos.rtc_us : 0;
+  trigger_clock_continue_from(pos.clock_us + offline_us);
+  
+  runtime = checkpoint_run.runtime;
+  runtime.sequenceVM = pos.vm;
+  runtime.nextAction = pos.next;
+  runtime.frameCount = pos.frameCount;
+  runtime.missedFrames = pos.missedFrames;
+  runtime.lateFrames = pos.lateFrames;
+  runtime.scheduleShift = pos.scheduleShift;
+  runtime.paused = pos.paused;
+  runtime.pausedAt = pos.pausedAt;
+  runtime.pausedTotal = pos.pausedTotal;
+  runtime.pausedFrames = pos.pausedFrames;
+  runtime.currentPhaseStartTime = trigger_clock_now_us();
+  runtime.holdActive = false;
+  runtime.waiting_for_completion = false;
+  runtime.logic_completed = false;
+  sequence_code = checkpoint_run.code;
+  timer_run_resumed = true;
+  
+  timer_system_hardware_init();
+  
+  // Überfällige Frames behandelt der erste Dispatch nach der Catch-up-Policy
+  trigger_clock_lock();
+  reset_frame_log();
+  if (!runtime.paused) schedule_sequence_action();
+  timer_logged_frame_count = runtime.frameCount;
+  timer_logged_missed_count = runtime.missedFrames;
+  trigger_clock_unlock();
+  
+  checkpoint_rtc = pos;
+  checkpoint_active = true;
+  checkpoint_run_start = run_start;
+  checkpoint_saved_frame = pos.frameCount;
+  checkpoint_saved_us = pos.clock_us;
+  
+  if (grid_known) {
+    DEBUG_PRINTF("Run resumed from checkpoint: frame %d, %lu s offline, original grid kept\n", 
+                 pos.frameCount, (unsigned long)(offline_us / 1000000));
+  } else {
+    DEBUG_PRINTF("Run resumed from checkpoint: frame %d - RTC time lost, grid shifted by the outage\n", 
+                 pos.frameCount);
+  }
+  return true;
+}
+
+void print_checkpoint_status() {
+  Serial.println("=== Run Checkpoint ===");
+  if (!checkpoint_active) {
+    Serial.println("No run checkpointed");
+  } else {
+    Serial.printf("Run: %d frames so far, RTC copy at frame %d\n", 
+                  runtime.frameCount, checkpoint_rtc.frameCount);
+    Serial.printf("NVS: frame %d, %lu s ago\n", checkpoint_saved_frame, 
+                  (unsigned long)((trigger_clock_now_us() - checkpoint_saved_us) / 1000000));
+  }
+  Serial.printf("NVS writes since boot: %lu (every %d frames, >= %d s apart)\n", 
+                (unsigned long)checkpoint_writes, CHECKPOINT_EVERY_FRAMES, CHECKPOINT_MIN_INTERVAL_MS / 1000);
+  Serial.println("======================");
+}
+
+#endif // CHECKPOINT_H
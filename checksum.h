@@ -0,0 +1,34 @@
+/*
+=============================================================================
+checksum.h - FNV-1a für Zustände im RTC-Speicher und NVS
+=============================================================================
+Deep-Sleep-Zustand, Checkpoints und der Uhr-Referenzpunkt überleben Resets
+im RTC-Speicher bzw. NVS. Eine Prüfsumme über die Nutzdaten (ab dem Feld
+nach magic/checksum) erkennt halb geschriebene oder zufällige Inhalte.
+=============================================================================
+*/
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+uint32_t fnv1a(const void *data, size_t length);
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+uint32_t fnv1a(const void *data, size_t length) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+#endif // CHECKSUM_H
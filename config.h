@@ -13,10 +13,21 @@ config.h - Hardware Configuration & System Constants
 #define SERVO_PIN 9
 #define SERVO_START_POSITION 0      // Adjustable start position (0-180°)
 #define SERVO_END_POSITION 90       // Adjustable end position (0-180°) 
-#define SERVO_ACTIVATION_TIME 0.6   // Adjustable activation time in seconds
+#define SERVO_ACTIVATION_MS 600     // Adjustable activation time in milliseconds
 #define SERVO_ABSOLUTE_MAX_POSITION 90    // The true 100% position (never changes)
 extern int servoAbsoluteMaxPosition;      // Runtime variable for absolute max
 
+// Elektro-Ausgang (Optokoppler-Paar)
+#define ELEKTRO_FOCUS_PIN       5     // Optokoppler 1 (Fokus)
+#define ELEKTRO_RELEASE_PIN     6     // Optokoppler 2 (Release)
+
+// Zusätzliche Ausgänge für Multi-Kamera-Rigs (outputs.h)
+#define OUTPUT_MAX_CHANNELS     6     // Servo + Elektro + 4 frei belegbare Kanäle
+#define OUTPUT_FREE_PINS        {10, 11, 16, 17}   // Nicht von Display/Touch/Encoder/Akku belegt
+#define OUTPUT_MAX_OFFSET_MS    5000  // Versatz eines Kanals zur Frame-Deadline
+#define OUTPUT_MIN_WIDTH_MS     5
+#define OUTPUT_MAX_WIDTH_MS     5000
+
 // Timer Colors (add to existing color definitions)
 #define COLOR_TIMER_PRIMARY   0x007BFF    // Blue for main countdown
 #define COLOR_TIMER_SECONDARY 0x808080    // Gray for release phase
@@ -49,8 +60,11 @@ extern int servoAbsoluteMaxPosition;      // Runtime variable for absolute max
 // =============================================================================
 #define VALUE_INCREMENT_SMALL   1    // Small increment (1 second)
 #define VALUE_INCREMENT_LARGE   10   // Large increment (10 seconds)
+#define VALUE_INCREMENT_TENTH   100  // Zehntelsekunde für ms-Werte (VALUE_FORMAT_MM_SS_T)
+#define VALUE_MAX_MS            3599900 // Maximum ms-Wert (59:59.9)
 #define VALUE_MIN_SECONDS       0    // Minimum value (00:00)
 #define VALUE_MAX_SECONDS       3599 // Maximum value (59:59)
+#define VALUE_MAX_DURATION_S    2592000 // Maximum Dauer (30 Tage) - als ms noch in uint32
 
 // Adaptive encoder configuration - VEREINFACHT
 #define ENCODER_SPEED_FAST_MS     40   // Fast rotation threshold (time between clicks)
@@ -75,6 +89,73 @@ extern int servoAbsoluteMaxPosition;      // Runtime variable for absolute max
 #define VALUE_FORMAT_MM_SS      0    // MM:SS format (minutes:seconds)
 #define VALUE_FORMAT_SS         1    // SS format (seconds only)
 #define VALUE_FORMAT_COUNT      2    // Simple counter format
+#define VALUE_FORMAT_MM_SS_T    3    // MM:SS.t format - Wert in Millisekunden
+#define VALUE_FORMAT_DURATION   4    // MM:SS bis 1 h, dann 1h05m, ab 1 Tag 3d04h - Wert in Sekunden
+#define VALUE_FORMAT_RAMP       5    // MM:SS, 0 = OFF (T-Lapse Ramp-Endabstand in Sekunden)
+#define VALUE_FORMAT_INTERVAL   6    // Wie DURATION, 0 = EXT (Auslösung über den externen Trigger-Eingang)
+#define VALUE_FORMAT_HZ         7    // "10Hz" - Burst-Rate
+#define VALUE_FORMAT_PULSE_MS   8    // "30ms" - Burst-Pulsbreite
+
+// =============================================================================
+// ELEKTRO BURST CONFIGURATION
+// =============================================================================
+#define BURST_MAX_COUNT         100  // Max. Impulse pro Burst
+#define BURST_MAX_RATE_HZ       20   // Max. Impulsrate
+#define BURST_MIN_PULSE_MS      5    // Kürzeste Release-Pulsbreite
+#define BURST_MIN_GAP_MS        10   // Min. LOW-Zeit zwischen zwei Burst-Impulsen
+#define BURST_DEFAULT_COUNT     5
+#define BURST_DEFAULT_RATE_HZ   10
+#define BURST_DEFAULT_PULSE_MS  30
+
+// =============================================================================
+// EXTERNAL TRIGGER CONFIGURATION
+// =============================================================================
+#define EXT_TRIGGER_MAX_DELAY_MS       10000 // Verzögerung Flanke -> Release
+#define EXT_TRIGGER_MAX_LOCKOUT_MS     60000 // Sperrzeit nach einer Auslösung (Prellen, Mehrfach-Flanken)
+#define EXT_TRIGGER_DEFAULT_LOCKOUT_MS 500
+
+// =============================================================================
+// FOCUS / WAKE CONFIGURATION
+// =============================================================================
+#define FOCUS_DEFAULT_LEAD_MS     3000  // Fokus-Vorlauf vor dem Release
+#define FOCUS_DEFAULT_DURATION_MS 3000  // Dauer des Fokus-Signals
+#define FOCUS_MAX_MS              30000
+#define FOCUS_MERGE_GAP_MS        200   // Kürzere Lücken zwischen zwei Fokus-Fenstern werden überbrückt
+
+// =============================================================================
+// LOW-POWER RUN CONFIGURATION
+// =============================================================================
+#define LOW_POWER_IDLE_MS         30000 // Ohne Bedienung während eines Laufs -> Display aus, Light-Sleep
+#define LOW_POWER_MIN_SLEEP_MS    20    // Kürzere Lücken bis zur nächsten Deadline lohnen keinen Sleep
+#define LOW_POWER_MAX_SLEEP_MS    60000 // Spätestens dann aufwachen (Akku, Schalter)
+#define LOW_POWER_GUARD_US        500   // Zusätzlicher Vorlauf vor der Deadline
+#define LOW_POWER_WAKE_INIT_US    1500  // Aufwach-Overhead bis zur ersten Messung
+#define BATTERY_LOW_POWER_UPDATE_MS 30000 // Fuel-Gauge-Abfrage bei ausgeschaltetem Display
+#define IDLE_MAX_WAIT_MS          50    // Obergrenze der Loop-Wartezeit (Serial wird nur gepollt)
+#define BATTERY_UPDATE_MS         500   // Fuel-Gauge-Abfrage bei eingeschaltetem Display
+#define DEEP_SLEEP_MIN_MS         60000 // Deep-Sleep nur bei so großen Lücken bis zur nächsten Deadline
+#define DEEP_SLEEP_BOOT_INIT_MS   1000  // Boot bis Dispatch bis zur ersten Messung
+#define DEEP_SLEEP_GUARD_MS       200   // Zusätzlicher Vorlauf vor der Deadline
+
+// =============================================================================
+// RUN CHECKPOINT CONFIGURATION
+// =============================================================================
+#define CHECKPOINT_EVERY_FRAMES   10    // NVS-Checkpoint alle N Frames (RTC-Kopie nach jedem Frame)
+#define CHECKPOINT_MIN_INTERVAL_MS 30000 // ... aber höchstens so oft - begrenzt den Flash-Verschleiß
+
+// =============================================================================
+// WALL CLOCK / SCHEDULED START CONFIGURATION
+// =============================================================================
+#define WALLCLOCK_MIN_CAL_S       3600  // Drift erst messen, wenn zwei Syncs so weit auseinander liegen
+#define WALLCLOCK_MAX_DRIFT_PPM   5000  // Größere Messwerte sind Bedienfehler (falsche Uhrzeit gesendet)
+
+// =============================================================================
+// MULTI-DEVICE TIME SYNC CONFIGURATION
+// =============================================================================
+#define TIMESYNC_BURST            8     // Messungen je Runde - die kürzeste Laufzeit zählt
+#define TIMESYNC_MAX_DELAY_MS     200   // Längere Round-Trips werden verworfen
+#define TIMESYNC_MIN_DRIFT_S      60    // Drift erst messen, wenn zwei Runden so weit auseinander liegen
+#define TIMESYNC_MAX_DRIFT_PPM    500   // Quarz + RTC im Light-Sleep - mehr ist ein anderer Master
 
 // =============================================================================
 // DISPLAY SETTINGS
@@ -135,11 +216,19 @@ extern int servoAbsoluteMaxPosition;      // Runtime variable for absolute max
 // =============================================================================
 #define SERIAL_BAUD_RATE      115200
 #define DEBUG_ENABLED         true
+#define PERF_PROFILER_ENABLED true    // Zyklenzähler um die Loop-Stufen (Serial "perf")
+#define PERF_WINDOW_SAMPLES   4096    // Je Stufe: danach Histogramm halbieren - Statistik bleibt gleitend
 
-#if DEBUG_ENABLED
+#if DEBUG_ENABLED && defined(ARDUINO)
   #define DEBUG_PRINT(x)      Serial.print(x)
   #define DEBUG_PRINTLN(x)    Serial.println(x)
   #define DEBUG_PRINTF(...)   Serial.printf(__VA_ARGS__)
+#elif DEBUG_ENABLED
+  // Host-Build (tests/): kein Serial - nur formatierte Ausgaben nach stdout
+  #include <stdio.h>
+  #define DEBUG_PRINT(x)
+  #define DEBUG_PRINTLN(x)
+  #define DEBUG_PRINTF(...)   printf(__VA_ARGS__)
 #else
   #define DEBUG_PRINT(x)
   #define DEBUG_PRINTLN(x)
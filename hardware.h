@@ -13,6 +13,7 @@ hardware.h - Hardware Abstraction Layer with RotaryEncoder Library
 #include <Arduino_GFX_Library.h>
 #include <RotaryEncoder.h>  // NEW: Include RotaryEncoder library
 #include "config.h"
+#include "perf.h"
 
 // =============================================================================
 // HARDWARE OBJECTS
@@ -102,9 +103,12 @@ int encoder_smoothing_index = 0;
 int current_speed_level = 2; // Start at slowest level
 int last_encoder_position = 0;  // Track position for delta calculation
 
+extern void low_power_wake_loop_from_isr();   // low_power.h - Loop sofort wecken
+
 // NEW: Interrupt handler for RotaryEncoder library
 void IRAM_ATTR check_encoder_position() {
   encoder->tick(); // Library handles all the logic
+  low_power_wake_loop_from_isr();
 }
 
 // Button ISR - UNCHANGED
@@ -113,6 +117,7 @@ void IRAM_ATTR encoder_button_isr() {
   if (current_time - last_button_press > ENCODER_DEBOUNCE_MS) {
     encoder_button_pressed = true;
     last_button_press = current_time;
+    low_power_wake_loop_from_isr();
   }
 }
 
@@ -374,6 +379,7 @@ void my_print(const char *buf) {
 #endif
 
 void my_disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+  uint32_t perf_start = perf_begin();
   uint32_t w = (area->x2 - area->x1 + 1);
   uint32_t h = (area->y2 - area->y1 + 1);
 
@@ -384,6 +390,7 @@ void my_disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *c
 #endif
 
   lv_disp_flush_ready(disp_drv);
+  perf_end(PERF_DISP_FLUSH, perf_start);
 }
 
 void touchpad_read_cb(lv_indev_drv_t *indev_drv, lv_indev_data_t *data) {
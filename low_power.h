@@ -0,0 +1,511 @@
+/*
+=============================================================================
+low_power.h - Light-Sleep zwischen den Frames langer Läufe
+=============================================================================
+Bei einem 5-Minuten-Intervall dreht app_loop() sonst alle 5 ms eine Runde
+(LVGL, Fuel-Gauge, Encoder). Nach LOW_POWER_IDLE_MS ohne Bedienung geht das
+Display aus, und zwischen zwei Scheduler-Events schläft der Chip im
+Light-Sleep. Aufgeweckt wird er:
+  - vom RTC-Timer kurz vor der nächsten Deadline (minus gemessenem Overhead),
+  - per GPIO von Encoder, Touch, Power-Schalter oder Ladeanschluss,
+  - vom BLE-Controller, wo der Chip das unterstützt.
+Die eigentliche Flanke feuert weiterhin der esp_timer One-Shot.
+
+Mit app_state.deep_sleep parkt ein Lauf bei Lücken ab DEEP_SLEEP_MIN_MS
+Runtime, Programm und Scheduler-Queue im RTC-Speicher und geht in den
+Deep-Sleep. Nach dem Timer-Wake läuft nur der Hot-Path (kein UI, kein BLE):
+Frame feuern, wieder schlafen. Erst Bedienung oder Laufende startet das UI.
+Ein geplanter Start (wall_clock.h) schläft bis zum Start auch ohne diese
+Einstellungen.
+
+Ohne Sleep wartet die Loop nicht mehr pauschal 5 ms, sondern bis zum
+frühesten von: nächstem LVGL-Timer (Rückgabe von lv_timer_handler()),
+nächster Scheduler-Deadline, nächster Akku-Abfrage, IDLE_MAX_WAIT_MS.
+Gewartet wird auf eine Task-Notification - Encoder-ISR, BLE-Callbacks,
+Control- und Housekeeping-Task wecken die Loop sofort.
+=============================================================================
+*/
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "trigger_clock.h"
+#include "scheduler.h"
+#include "checksum.h"
+
+#include <stddef.h>
+
+#if defined(ESP32)
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+// =============================================================================
+// LOW-POWER STATE
+// =============================================================================
+struct LowPowerStats {
+  uint32_t sleeps;                // Erfolgreiche Light-Sleeps
+  uint32_t gpio_wakes;            // Davon durch Bedienung beendet
+  uint32_t rejected;              // esp_light_sleep_start() abgelehnt (z.B. Funk aktiv)
+  uint64_t slept_us;              // Summe der Schlafzeit
+  uint32_t wake_overhead_us;      // Gleitender Mittelwert: so viel später als geplant wach
+  uint32_t wake_overhead_max_us;
+};
+
+struct IdleWaitStats {
+  uint32_t waits;                 // Blockierende Wartephasen der Loop
+  uint32_t woken;                 // Davon vorzeitig per Notification beendet
+  uint32_t skipped;               // Wartezeit 0 - Eingabe oder Deadline stand an
+  uint64_t waited_ms;             // Summe der geplanten Wartezeit
+};
+
+// Alles, was ein Lauf zum Fortsetzen nach dem Deep-Sleep braucht
+#define DEEP_SLEEP_MAGIC 0x52533144   // "RS1D"
+
+struct DeepSleepRunState {
+  uint32_t magic;
+  uint32_t checksum;              // FNV-1a ab sleep_clock_us
+  uint64_t sleep_clock_us;        // trigger_clock_now_us() beim Einschlafen
+  uint64_t sleep_rtc_us;          // RTC-Zeit beim Einschlafen (läuft im Deep-Sleep weiter)
+  uint64_t wake_at_us;            // Geplanter Timer-Wake (Trigger-Zeitbasis)
+  TimerRuntime runtime;
+  SequenceCode code;
+  SchedulerQueue queue;
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void low_power_init();
+void low_power_idle(uint32_t lvgl_wait_ms);   // Ende von app_loop(), Rückgabe von lv_timer_handler()
+uint32_t low_power_next_wake_ms(uint32_t lvgl_wait_ms);
+void low_power_wait(uint32_t wait_ms);        // Blockiert bis Timeout oder low_power_wake_loop()
+void low_power_wake_loop();                   // Task-Kontext: Loop sofort wecken
+void low_power_wake_loop_from_isr();          // Dito aus einer ISR
+void low_power_note_activity();     // Bedienung außerhalb von LVGL (Encoder)
+void low_power_wake_screen();
+void set_low_power(bool enabled);
+bool low_power_run_active();
+bool low_power_sleep_allowed();
+String low_power_status_string();   // BLE: POWER:<on>:<sleeps>:<wake_avg_us>:<wake_max_us>:<slept_s>:<deep>:<deep_sleeps>:<boot_ms>
+void print_low_power_status();
+
+// Deep-Sleep mit Fortsetzung aus dem RTC-Speicher
+void set_deep_sleep(bool enabled);
+bool deep_sleep_resume();           // Nach settings_init(): true wenn ein Lauf fortgesetzt wird
+bool deep_sleep_possible(uint64_t deadline, uint64_t now);
+void deep_sleep_enter(uint64_t deadline);
+void deep_sleep_idle();             // Hot-Path: schlafen sobald möglich, sonst delay(5)
+bool deep_sleep_input_seen();       // Hot-Path: Bedienung seit dem Wake -> UI starten
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+LowPowerStats low_power_stats = {0, 0, 0, 0, LOW_POWER_WAKE_INIT_US, 0};
+IdleWaitStats idle_wait_stats = {0, 0, 0, 0};
+bool low_power_screen_off = false;
+
+extern volatile bool tasks_battery_active;   // tasks.h
+
+#if defined(ESP32)
+TaskHandle_t low_power_loop_task = nullptr;   // Arduino-loopTask, gesetzt in low_power_init()
+#endif
+
+RTC_DATA_ATTR DeepSleepRunState deep_sleep_state;
+RTC_DATA_ATTR uint32_t deep_sleep_count = 0;                             // Seit dem Einschalten
+RTC_DATA_ATTR uint32_t deep_sleep_boot_us = DEEP_SLEEP_BOOT_INIT_MS * 1000;  // Timer-Wake bis Dispatch bereit
+bool deep_sleep_hot_path = false;       // Timer-Wake: kein UI, nur Scheduler
+uint8_t deep_sleep_wake_levels[5];      // Pegel der Wake-Pins beim Fortsetzen
+
+// Wechsel an einem dieser Pins weckt den Chip (Pegel entgegen dem aktuellen)
+const uint8_t low_power_wake_pins[] = {ENCODER_PIN_A, ENCODER_PIN_B, Touch_INT, POWER_SWITCH_PIN, CHARGE_PIN};
+
+void low_power_init() {
+  low_power_stats = {0, 0, 0, 0, LOW_POWER_WAKE_INIT_US, 0};
+  idle_wait_stats = {0, 0, 0, 0};
+  low_power_screen_off = false;
+#if defined(ESP32)
+  low_power_loop_task = xTaskGetCurrentTaskHandle();
+#endif
+  DEBUG_PRINTF("Low-power runs: %s (sleep after %d s idle)\n",
+               app_state.low_power ? "ON" : "OFF", LOW_POWER_IDLE_MS / 1000);
+}
+
+bool low_power_run_active() {
+  switch (runtime.state) {
+    case TIMER_DELAY_RUNNING:
+    case TLAPSE_RUNNING:
+    case INTERVAL_RUNNING:
+    case SEQUENCE_RUNNING:
+      return !runtime.logic_completed;
+    default:
+      return false;   // Burst, Bulb-Hold und Completion sind kurz - wach bleiben
+  }
+}
+
+bool low_power_sleep_allowed() {
+  // Laufende Flanken, Messungen, Funkverbindung oder Laden -> nicht schlafen
+  trigger_clock_lock();
+  bool outputs_busy = is_any_system_active();
+  trigger_clock_unlock();
+
+  return !outputs_busy && !lag_measure_running && !ble_state.client_connected &&
+         !battery_state.is_charging;
+}
+
+void low_power_note_activity() {
+  lv_disp_trig_activity(NULL);
+}
+
+void low_power_wake_screen() {
+  if (!low_power_screen_off) return;
+  low_power_screen_off = false;
+  battery_low_power = false;
+  backlight_on();
+  DEBUG_PRINTLN("Low power: display on");
+}
+
+void set_low_power(bool enabled) {
+  app_state.low_power = enabled;
+  save_app_state();
+  if (!enabled) low_power_wake_screen();
+  DEBUG_PRINTF("Low-power runs: %s\n", enabled ? "ON" : "OFF");
+}
+
+#if defined(ESP32)
+void low_power_sleep(uint64_t sleep_us) {
+  for (uint8_t i = 0; i < sizeof(low_power_wake_pins); i++) {
+    gpio_num_t pin = (gpio_num_t)low_power_wake_pins[i];
+    gpio_wakeup_enable(pin, digitalRead(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+  }
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_timer_wakeup(sleep_us);
+#if SOC_PM_SUPPORT_BT_WAKEUP
+  esp_sleep_enable_bt_wakeup();
+#endif
+
+  Serial.flush();
+  uint64_t before = trigger_clock_now_us();
+  esp_err_t result = esp_light_sleep_start();
+  uint64_t after = trigger_clock_now_us();
+
+  // gpio_wakeup_enable() hat den Interrupt-Typ überschrieben - Encoder wieder auf beide Flanken
+  for (uint8_t i = 0; i < sizeof(low_power_wake_pins); i++) {
+    gpio_wakeup_disable((gpio_num_t)low_power_wake_pins[i]);
+  }
+  gpio_set_intr_type((gpio_num_t)ENCODER_PIN_A, GPIO_INTR_ANYEDGE);
+  gpio_set_intr_type((gpio_num_t)ENCODER_PIN_B, GPIO_INTR_ANYEDGE);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+
+  if (result != ESP_OK) {
+    low_power_stats.rejected++;
+    return;
+  }
+
+  low_power_stats.sleeps++;
+  low_power_stats.slept_us += after - before;
+
+  if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER) {
+    // Overhead = Verspätung gegenüber dem geplanten Aufwachzeitpunkt
+    uint64_t planned = before + sleep_us;
+    uint32_t overhead = after > planned ? (uint32_t)min(after - planned, (uint64_t)100000) : 0;
+    low_power_stats.wake_overhead_us = (low_power_stats.wake_overhead_us * 7 + overhead) / 8;
+    low_power_stats.wake_overhead_max_us = max(low_power_stats.wake_overhead_max_us, overhead);
+  } else {
+    // Bedienung oder Funk - Display wieder an, Idle-Zeit neu starten
+    low_power_stats.gpio_wakes++;
+    low_power_note_activity();
+    low_power_wake_screen();
+  }
+}
+#else
+void low_power_sleep(uint64_t sleep_us) {
+  delay((unsigned long)US_TO_MS(sleep_us));
+}
+#endif
+
+// =============================================================================
+// LOOP IDLE - bis zur nächsten Deadline warten statt fester 5 ms
+// =============================================================================
+uint32_t low_power_next_wake_ms(uint32_t lvgl_wait_ms) {
+  // Serial hat keinen Wake-Hook, BLE-Befehle kommen normalerweise mit Notification
+  if (Serial.available() || ble_ring_count(ble_rx_ring) > 0) return 0;
+
+  uint32_t wait_ms = min(lvgl_wait_ms, (uint32_t)IDLE_MAX_WAIT_MS);
+
+  // Nächstes Scheduler-Event - mindestens 1 ms, eine überfällige Deadline
+  // bedient der Control-Task bzw. die Loop im nächsten Durchlauf
+  uint64_t deadline;
+  trigger_clock_lock();
+  bool has_deadline = scheduler_next_deadline(deadline);
+  trigger_clock_unlock();
+  if (has_deadline) {
+    uint64_t now = trigger_clock_now_us();
+    uint32_t deadline_ms = deadline > now ? (uint32_t)min((deadline - now + 999) / 1000, (uint64_t)IDLE_MAX_WAIT_MS) : 1;
+    wait_ms = min(wait_ms, deadline_ms);
+  }
+
+  // Akku-Abfrage: mit Housekeeping-Task kommt das Sample samt Notification
+  if (tasks_battery_active && !housekeeping_running()) {
+    wait_ms = min(wait_ms, battery_sample_wait_ms());
+  }
+  return wait_ms;
+}
+
+void low_power_wait(uint32_t wait_ms) {
+  if (wait_ms == 0) {
+    idle_wait_stats.skipped++;
+    return;
+  }
+  idle_wait_stats.waits++;
+  idle_wait_stats.waited_ms += wait_ms;
+
+#if defined(ESP32)
+  if (low_power_loop_task) {
+    // Aufrunden auf ganze Ticks - lieber einen Tick später als zu früh wach
+    TickType_t ticks = max((TickType_t)1, (TickType_t)((wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS));
+    if (ulTaskNotifyTake(pdTRUE, ticks) > 0) idle_wait_stats.woken++;
+    return;
+  }
+#endif
+  delay(wait_ms);
+}
+
+#if defined(ESP32)
+void low_power_wake_loop() {
+  if (low_power_loop_task) xTaskNotifyGive(low_power_loop_task);
+}
+
+void IRAM_ATTR low_power_wake_loop_from_isr() {
+  if (!low_power_loop_task) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(low_power_loop_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+#else
+void low_power_wake_loop() {}
+void low_power_wake_loop_from_isr() {}
+#endif
+
+void low_power_idle(uint32_t lvgl_wait_ms) {
+  // Geplanter Start schläft immer - dafür wird das Gerät nachts aufgebaut
+  bool idle = lv_disp_get_inactive_time(NULL) >= LOW_POWER_IDLE_MS;
+  bool enabled = app_state.low_power || timer_run_armed();
+  if (!enabled || !low_power_run_active() || !idle) {
+    low_power_wake_screen();
+    low_power_wait(low_power_next_wake_ms(lvgl_wait_ms));
+    return;
+  }
+
+  if (!low_power_screen_off) {
+    low_power_screen_off = true;
+    battery_low_power = true;
+    backlight_off();
+    DEBUG_PRINTLN("Low power: display off until next input");
+  }
+
+  if (!low_power_sleep_allowed()) {
+    low_power_wait(low_power_next_wake_ms(lvgl_wait_ms));
+    return;
+  }
+
+  // Aufwachen um den gemessenen Overhead früher als die nächste Deadline
+  uint64_t deadline;
+  trigger_clock_lock();
+  bool has_deadline = scheduler_next_deadline(deadline);
+  trigger_clock_unlock();
+
+  uint64_t now = trigger_clock_now_us();
+  if (has_deadline && deep_sleep_possible(deadline, now)) {
+    deep_sleep_enter(deadline);   // Kehrt nur zurück, wenn der Deep-Sleep nicht möglich war
+    return;
+  }
+  uint64_t early = low_power_stats.wake_overhead_us + LOW_POWER_GUARD_US;
+  uint64_t sleep_us = MS_TO_US(LOW_POWER_MAX_SLEEP_MS);
+  if (has_deadline) {
+    if (deadline <= now + early + MS_TO_US(LOW_POWER_MIN_SLEEP_MS)) {
+      low_power_wait(low_power_next_wake_ms(lvgl_wait_ms));
+      return;
+    }
+    sleep_us = min(sleep_us, deadline - now - early);
+  }
+
+  low_power_sleep(sleep_us);
+}
+
+// =============================================================================
+// DEEP SLEEP - Lauf im RTC-Speicher parken, Hot-Path nach dem Timer-Wake
+// =============================================================================
+uint32_t deep_sleep_checksum() {
+  return fnv1a(&deep_sleep_state.sleep_clock_us, sizeof(deep_sleep_state) - offsetof(DeepSleepRunState, sleep_clock_us));
+}
+
+void set_deep_sleep(bool enabled) {
+  app_state.deep_sleep = enabled;
+  save_app_state();
+  DEBUG_PRINTF("Deep sleep between frames: %s\n", enabled ? "ON" : "OFF");
+}
+
+bool deep_sleep_possible(uint64_t deadline, uint64_t now) {
+  if (!(app_state.deep_sleep || timer_run_armed()) || runtime.holdActive) return false;
+  if (deadline < now + MS_TO_US(DEEP_SLEEP_MIN_MS)) return false;
+  
+  // Nur geplante Starts in der Queue - laufende Flanken überleben keinen Reset
+  trigger_clock_lock();
+  bool parkable = true;
+  for (uint8_t i = 0; i < scheduler_queue.count; i++) {
+    uint8_t type = scheduler_queue.events[i].type;
+    if (type != EVENT_RELEASE_START && type != EVENT_FOCUS_START) parkable = false;
+  }
+  trigger_clock_unlock();
+  return parkable;
+}
+
+void deep_sleep_enter(uint64_t deadline) {
+#if defined(ESP32)
+  uint64_t lead = deep_sleep_boot_us + MS_TO_US(DEEP_SLEEP_GUARD_MS);
+  
+  trigger_clock_lock();
+  uint64_t now = trigger_clock_now_us();
+  deep_sleep_state.sleep_clock_us = now;
+  deep_sleep_state.sleep_rtc_us = trigger_clock_rtc_us();
+  deep_sleep_state.wake_at_us = deadline - lead;
+  deep_sleep_state.runtime = runtime;
+  deep_sleep_state.code = sequence_code;
+  deep_sleep_state.queue = scheduler_queue;
+  deep_sleep_state.checksum = deep_sleep_checksum();
+  deep_sleep_state.magic = DEEP_SLEEP_MAGIC;
+  trigger_clock_disarm();
+  trigger_clock_unlock();
+  
+  deep_sleep_count++;
+  DEBUG_PRINTF("Deep sleep for %lu s (frame %d done, boot lead %lu ms)\n",
+               (unsigned long)((deep_sleep_state.wake_at_us - now) / 1000000), runtime.frameCount,
+               (unsigned long)US_TO_MS(lead));
+  
+  // Optokoppler während des Schlafs sicher LOW halten
+  outputs_sleep_hold(true);
+  backlight_off();
+  
+  esp_sleep_enable_timer_wakeup(deep_sleep_state.wake_at_us - now);
+#if SOC_GPIO_SUPPORT_DEEPSLEEP_WAKEUP
+  // Bedienung weckt ebenfalls - nur LP-fähige Pins (ESP32-C6: GPIO 0-7)
+  for (uint8_t i = 0; i < sizeof(low_power_wake_pins); i++) {
+    gpio_num_t pin = (gpio_num_t)low_power_wake_pins[i];
+    if (!esp_sleep_is_valid_wakeup_gpio(pin)) continue;
+    esp_deep_sleep_enable_gpio_wakeup(1ULL << pin, 
+                                      digitalRead(pin) ? ESP_GPIO_WAKEUP_GPIO_LOW : ESP_GPIO_WAKEUP_GPIO_HIGH);
+  }
+#endif
+  Serial.flush();
+  esp_deep_sleep_start();
+#endif
+}
+
+bool deep_sleep_resume() {
+#if defined(ESP32)
+  if (esp_reset_reason() != ESP_RST_DEEPSLEEP) {
+    deep_sleep_state.magic = 0;
+    return false;
+  }
+#endif
+  if (deep_sleep_state.magic != DEEP_SLEEP_MAGIC) return false;
+  deep_sleep_state.magic = 0;   // Nur einmal fortsetzen
+  if (deep_sleep_state.checksum != deep_sleep_checksum()) {
+    DEBUG_PRINTLN("ERROR: Deep sleep run state corrupt - starting fresh");
+    return false;
+  }
+  
+  // Zeitbasis um die Schlafdauer fortsetzen - alle gespeicherten Deadlines bleiben gültig
+  uint64_t slept_us = trigger_clock_rtc_us() - deep_sleep_state.sleep_rtc_us;
+  trigger_clock_continue_from(deep_sleep_state.sleep_clock_us + slept_us);
+  
+  runtime = deep_sleep_state.runtime;
+  sequence_code = deep_sleep_state.code;
+  timer_run_resumed = true;
+  
+  timer_system_hardware_init();
+  servo_initialization_complete = true;   // Servo stand beim Einschlafen in Startposition
+#if defined(ESP32)
+  outputs_sleep_hold(false);
+  deep_sleep_hot_path = (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER);
+#endif
+  
+  trigger_clock_lock();
+  scheduler_queue = deep_sleep_state.queue;
+  scheduler_rearm();
+  timer_logged_frame_count = runtime.frameCount;
+  timer_logged_missed_count = runtime.missedFrames;
+  trigger_clock_unlock();
+  
+  // Boot-Overhead messen - der nächste Wake kommt um so viel früher
+  uint64_t now = trigger_clock_now_us();
+  if (deep_sleep_hot_path) {
+    uint32_t boot_us = now > deep_sleep_state.wake_at_us ? 
+                       (uint32_t)min(now - deep_sleep_state.wake_at_us, (uint64_t)5000000) : 0;
+    deep_sleep_boot_us = (deep_sleep_boot_us * 3 + boot_us) / 4;
+  }
+  
+  for (uint8_t i = 0; i < sizeof(low_power_wake_pins); i++) {
+    deep_sleep_wake_levels[i] = digitalRead(low_power_wake_pins[i]);
+  }
+  
+  DEBUG_PRINTF("Resumed run after %lu s deep sleep (%s wake, boot %lu ms), %d frames so far\n",
+               (unsigned long)(slept_us / 1000000), deep_sleep_hot_path ? "timer" : "input",
+               (unsigned long)(deep_sleep_boot_us / 1000), runtime.frameCount);
+  return true;
+}
+
+bool deep_sleep_input_seen() {
+  for (uint8_t i = 0; i < sizeof(low_power_wake_pins); i++) {
+    if (digitalRead(low_power_wake_pins[i]) != deep_sleep_wake_levels[i]) return true;
+  }
+  return false;
+}
+
+void deep_sleep_idle() {
+  uint64_t deadline;
+  trigger_clock_lock();
+  bool has_deadline = scheduler_next_deadline(deadline);
+  bool outputs_busy = is_any_system_active();
+  trigger_clock_unlock();
+  
+  if (has_deadline && !outputs_busy && deep_sleep_possible(deadline, trigger_clock_now_us())) {
+    deep_sleep_enter(deadline);
+  }
+  delay(5);
+}
+
+String low_power_status_string() {
+  return String(app_state.low_power ? 1 : 0) + ":" + String(low_power_stats.sleeps) + ":" +
+         String(low_power_stats.wake_overhead_us) + ":" + String(low_power_stats.wake_overhead_max_us) + ":" +
+         String((unsigned long)(low_power_stats.slept_us / 1000000)) + ":" +
+         String(app_state.deep_sleep ? 1 : 0) + ":" + String(deep_sleep_count) + ":" + 
+         String(deep_sleep_boot_us / 1000);
+}
+
+void print_low_power_status() {
+  Serial.println("=== Low-Power Runs ===");
+  Serial.printf("Enabled: %s, display: %s\n", app_state.low_power ? "ON" : "OFF",
+                low_power_screen_off ? "OFF" : "ON");
+  Serial.printf("Sleeps: %lu (%lu woken by input, %lu rejected), slept %lu s\n",
+                (unsigned long)low_power_stats.sleeps, (unsigned long)low_power_stats.gpio_wakes,
+                (unsigned long)low_power_stats.rejected, (unsigned long)(low_power_stats.slept_us / 1000000));
+  Serial.printf("Wake overhead: avg %lu us, max %lu us (woken this much early)\n",
+                (unsigned long)low_power_stats.wake_overhead_us, (unsigned long)low_power_stats.wake_overhead_max_us);
+  Serial.printf("Deep sleep: %s (gaps >= %d s), %lu sleeps, boot-to-dispatch %lu ms\n",
+                app_state.deep_sleep ? "ON" : "OFF", DEEP_SLEEP_MIN_MS / 1000,
+                (unsigned long)deep_sleep_count, (unsigned long)(deep_sleep_boot_us / 1000));
+  Serial.printf("Loop idle: %lu waits, avg %lu ms, %lu woken early, %lu skipped\n",
+                (unsigned long)idle_wait_stats.waits,
+                (unsigned long)(idle_wait_stats.waits ? idle_wait_stats.waited_ms / idle_wait_stats.waits : 0),
+                (unsigned long)idle_wait_stats.woken, (unsigned long)idle_wait_stats.skipped);
+  Serial.println("======================");
+}
+
+#endif // LOW_POWER_H
@@ -0,0 +1,347 @@
+/*
+=============================================================================
+outputs.h - Ausgabekanäle für Multi-Kamera-Rigs
+=============================================================================
+Ein Frame fächert auf alle aktiven Kanäle auf. Kanal 0 ist der Hauptservo,
+Kanal 1 das Optokoppler-Paar auf GPIO 5/6 - beide mit festen Pins. Die
+Kanäle 2..5 lassen sich als weiterer Servo oder Optokoppler (Release, optional
+Fokus) auf die freien GPIOs legen. Jeder Kanal hat einen eigenen Versatz zur
+Frame-Deadline und eine eigene Impulsbreite (bzw. Servo-Haltezeit).
+Die Konfiguration liegt in einem eigenen NVS-Namespace (unabhängig von
+SETTINGS_VERSION).
+=============================================================================
+*/
+
+#ifndef OUTPUTS_H
+#define OUTPUTS_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <ESP32Servo.h>
+#include "config.h"
+
+#if defined(ESP32)
+#include "driver/gpio.h"
+#endif
+
+// =============================================================================
+// OUTPUT CONFIGURATION
+// =============================================================================
+#define OUTPUTS_NAMESPACE     "outputs"
+#define OUTPUTS_STORE_VERSION 1
+
+enum OutputType {
+  OUTPUT_OFF,
+  OUTPUT_SERVO,
+  OUTPUT_OPTO
+};
+
+struct OutputChannelConfig {
+  uint8_t type;             // OutputType
+  int8_t pin;               // Servo-Signal bzw. Release-Optokoppler (-1 = keiner)
+  int8_t focus_pin;         // Fokus-Optokoppler, nur OUTPUT_OPTO (-1 = keiner)
+  uint16_t offset_ms;       // Versatz zur Frame-Deadline
+  uint16_t width_ms;        // Release-Impuls bzw. Servo-Haltezeit
+};
+
+struct OutputStore {
+  uint8_t version;
+  OutputChannelConfig channels[OUTPUT_MAX_CHANNELS];
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void outputs_init();
+void outputs_defaults();
+void outputs_save();
+void outputs_attach();
+bool output_enabled(uint8_t channel);
+bool output_is_servo(uint8_t channel);
+uint16_t output_offset_ms(uint8_t channel);
+uint16_t output_width_ms(uint8_t channel);
+uint16_t outputs_max_width_ms();
+bool output_pin_available(int pin, uint8_t channel);
+bool output_configure(int channel, char type, int pin, int focus_pin, int offset_ms, int width_ms);
+
+// Zusatzkanäle (2..5) - Kanal 0/1 schaltet timer_system.h
+void output_drive(uint8_t channel, bool on);
+void outputs_extra_drive(bool on);    // Bulb: alle Zusatzkanäle halten / freigeben
+void outputs_extra_focus(bool on);    // Fokus-Optokoppler folgen dem Hauptfokus
+void outputs_extra_off();
+bool outputs_extra_active();
+void outputs_sleep_hold(bool hold);   // Optokoppler im Deep Sleep LOW halten
+
+char output_type_char(uint8_t type);
+String outputs_string();              // BLE: OUTPUTS:<i>:<S|O|->:<pin>:<focus>:<offset>:<width>,...
+void print_outputs();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+extern int servoStartPosition;
+extern int servoEndPosition;
+extern uint32_t servo_activation_us;
+extern uint32_t elektro_release_us;
+
+OutputStore output_store;
+Servo output_servos[OUTPUT_MAX_CHANNELS];     // Nur Zusatzkanäle, Kanal 0 nutzt cameraServo
+bool output_active[OUTPUT_MAX_CHANNELS] = {false};
+const int8_t output_free_pins[] = OUTPUT_FREE_PINS;
+
+void outputs_defaults() {
+  output_store.version = OUTPUTS_STORE_VERSION;
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    output_store.channels[i] = {OUTPUT_OFF, -1, -1, 0, SERVO_ACTIVATION_MS};
+  }
+  output_store.channels[0].type = OUTPUT_SERVO;
+  output_store.channels[0].pin = SERVO_PIN;
+  output_store.channels[1].type = OUTPUT_OPTO;
+  output_store.channels[1].pin = ELEKTRO_RELEASE_PIN;
+  output_store.channels[1].focus_pin = ELEKTRO_FOCUS_PIN;
+}
+
+void outputs_init() {
+  outputs_defaults();
+
+  Preferences prefs;
+  if (prefs.begin(OUTPUTS_NAMESPACE, true)) {
+    OutputStore stored;
+    size_t read = prefs.getBytes("channels", &stored, sizeof(stored));
+    prefs.end();
+
+    if (read == sizeof(stored) && stored.version == OUTPUTS_STORE_VERSION) {
+      // Pins der Hauptkanäle sind fest verdrahtet - nur Typ (an/aus) und Timing übernehmen
+      for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+        OutputChannelConfig ch = stored.channels[i];
+        if (i < 2) {
+          ch.pin = output_store.channels[i].pin;
+          ch.focus_pin = output_store.channels[i].focus_pin;
+          if (ch.type != OUTPUT_OFF) ch.type = output_store.channels[i].type;
+        }
+        output_store.channels[i] = ch;
+      }
+    }
+  }
+
+  // Haltezeiten einmal in µs umrechnen - die Flanken rechnen nur noch ganzzahlig
+  servo_activation_us = (uint32_t)MS_TO_US(output_store.channels[0].width_ms);
+  elektro_release_us = (uint32_t)MS_TO_US(output_store.channels[1].width_ms);
+  outputs_attach();
+
+  uint8_t enabled = 0;
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    if (output_enabled(i)) enabled++;
+  }
+  DEBUG_PRINTF("Outputs initialized - %d of %d channels active\n", enabled, OUTPUT_MAX_CHANNELS);
+}
+
+void outputs_save() {
+  Preferences prefs;
+  if (!prefs.begin(OUTPUTS_NAMESPACE, false)) {
+    DEBUG_PRINTLN("ERROR: Failed to open output config for writing");
+    return;
+  }
+  prefs.putBytes("channels", &output_store, sizeof(output_store));
+  prefs.end();
+}
+
+void outputs_attach() {
+  for (uint8_t i = 2; i < OUTPUT_MAX_CHANNELS; i++) {
+    const OutputChannelConfig &ch = output_store.channels[i];
+    output_active[i] = false;
+    if (ch.type == OUTPUT_SERVO) {
+      output_servos[i].attach(ch.pin);
+      output_servos[i].write(servoStartPosition);
+    } else if (ch.type == OUTPUT_OPTO) {
+      pinMode(ch.pin, OUTPUT);
+      digitalWrite(ch.pin, LOW);
+      if (ch.focus_pin >= 0) {
+        pinMode(ch.focus_pin, OUTPUT);
+        digitalWrite(ch.focus_pin, LOW);
+      }
+    }
+  }
+}
+
+bool output_enabled(uint8_t channel) {
+  return channel < OUTPUT_MAX_CHANNELS && output_store.channels[channel].type != OUTPUT_OFF;
+}
+
+bool output_is_servo(uint8_t channel) {
+  return output_store.channels[channel].type == OUTPUT_SERVO;
+}
+
+uint16_t output_offset_ms(uint8_t channel) {
+  return output_store.channels[channel].offset_ms;
+}
+
+uint16_t output_width_ms(uint8_t channel) {
+  return output_store.channels[channel].width_ms;
+}
+
+uint16_t outputs_max_width_ms() {
+  uint16_t widest = 0;
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    if (output_enabled(i)) widest = max(widest, (uint16_t)(output_offset_ms(i) + output_width_ms(i)));
+  }
+  return widest;
+}
+
+bool output_pin_available(int pin, uint8_t channel) {
+  bool free_pin = false;
+  for (uint8_t i = 0; i < sizeof(output_free_pins); i++) {
+    if (output_free_pins[i] == pin) free_pin = true;
+  }
+  if (!free_pin) return false;
+
+  // Nicht doppelt vergeben
+  for (uint8_t i = 2; i < OUTPUT_MAX_CHANNELS; i++) {
+    if (i == channel || output_store.channels[i].type == OUTPUT_OFF) continue;
+    if (output_store.channels[i].pin == pin || output_store.channels[i].focus_pin == pin) return false;
+  }
+  return true;
+}
+
+bool output_configure(int channel, char type, int pin, int focus_pin, int offset_ms, int width_ms) {
+  // Nur im Leerlauf aufrufen - der Aufrufer prüft runtime.state
+  if (channel < 0 || channel >= OUTPUT_MAX_CHANNELS) return false;
+  if (offset_ms < 0 || offset_ms > OUTPUT_MAX_OFFSET_MS) return false;
+  if (width_ms < OUTPUT_MIN_WIDTH_MS || width_ms > OUTPUT_MAX_WIDTH_MS) return false;
+
+  OutputChannelConfig ch = output_store.channels[channel];
+  switch (toupper(type)) {
+    case '-': ch.type = OUTPUT_OFF;   break;
+    case 'S': ch.type = OUTPUT_SERVO; break;
+    case 'O': ch.type = OUTPUT_OPTO;  break;
+    default: return false;
+  }
+
+  if (channel < 2) {
+    // Hauptkanäle: Typ und Pins fest, nur abschaltbar
+    if (ch.type != OUTPUT_OFF && ch.type != (channel == 0 ? OUTPUT_SERVO : OUTPUT_OPTO)) return false;
+  } else if (ch.type == OUTPUT_OFF) {
+    ch.pin = -1;
+    ch.focus_pin = -1;
+  } else {
+    if (ch.type == OUTPUT_SERVO) focus_pin = -1;
+    if (!output_pin_available(pin, channel)) return false;
+    if (focus_pin >= 0 && (focus_pin == pin || !output_pin_available(focus_pin, channel))) return false;
+    ch.pin = pin;
+    ch.focus_pin = focus_pin < 0 ? -1 : focus_pin;
+  }
+  ch.offset_ms = offset_ms;
+  ch.width_ms = width_ms;
+
+  // Alten Zusatzkanal freigeben, bevor die Pins neu belegt werden
+  if (channel >= 2) {
+    output_drive(channel, false);
+    if (output_store.channels[channel].type == OUTPUT_SERVO) output_servos[channel].detach();
+  }
+
+  output_store.channels[channel] = ch;
+  if (channel == 0) servo_activation_us = (uint32_t)MS_TO_US(width_ms);
+  if (channel == 1) elektro_release_us = (uint32_t)MS_TO_US(width_ms);
+  outputs_attach();
+  outputs_save();
+
+  DEBUG_PRINTF("Output %d: %c pin %d focus %d, offset %d ms, width %d ms\n", channel,
+               output_type_char(ch.type), ch.pin, ch.focus_pin, ch.offset_ms, ch.width_ms);
+  return true;
+}
+
+void output_drive(uint8_t channel, bool on) {
+  if (channel < 2 || channel >= OUTPUT_MAX_CHANNELS) return;
+  const OutputChannelConfig &ch = output_store.channels[channel];
+  if (ch.type == OUTPUT_SERVO) {
+    output_servos[channel].write(on ? servoEndPosition : servoStartPosition);
+  } else if (ch.type == OUTPUT_OPTO) {
+    digitalWrite(ch.pin, on ? HIGH : LOW);
+  } else {
+    return;
+  }
+  output_active[channel] = on;
+}
+
+void outputs_extra_drive(bool on) {
+  for (uint8_t i = 2; i < OUTPUT_MAX_CHANNELS; i++) {
+    output_drive(i, on);
+  }
+}
+
+void outputs_extra_focus(bool on) {
+  for (uint8_t i = 2; i < OUTPUT_MAX_CHANNELS; i++) {
+    const OutputChannelConfig &ch = output_store.channels[i];
+    if (ch.type == OUTPUT_OPTO && ch.focus_pin >= 0) digitalWrite(ch.focus_pin, on ? HIGH : LOW);
+  }
+}
+
+void outputs_extra_off() {
+  outputs_extra_drive(false);
+  outputs_extra_focus(false);
+}
+
+bool outputs_extra_active() {
+  for (uint8_t i = 2; i < OUTPUT_MAX_CHANNELS; i++) {
+    if (output_active[i]) return true;
+  }
+  return false;
+}
+
+void outputs_sleep_hold(bool hold) {
+#if defined(ESP32)
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    const OutputChannelConfig &ch = output_store.channels[i];
+    if (ch.type != OUTPUT_OPTO && i != 1) continue;   // Hauptpaar immer, auch abgeschaltet
+    int8_t pins[] = {ch.pin, ch.focus_pin};
+    for (uint8_t p = 0; p < 2; p++) {
+      if (pins[p] < 0) continue;
+      if (hold) {
+        digitalWrite(pins[p], LOW);
+        gpio_hold_en((gpio_num_t)pins[p]);
+      } else {
+        gpio_hold_dis((gpio_num_t)pins[p]);
+      }
+    }
+  }
+#endif
+}
+
+char output_type_char(uint8_t type) {
+  switch (type) {
+    case OUTPUT_SERVO: return 'S';
+    case OUTPUT_OPTO:  return 'O';
+    default:           return '-';
+  }
+}
+
+String outputs_string() {
+  String result = "";
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    const OutputChannelConfig &ch = output_store.channels[i];
+    if (i > 0) result += ",";
+    result += String(i) + ":" + output_type_char(ch.type) + ":" + String(ch.pin) + ":" +
+              String(ch.focus_pin) + ":" + String(ch.offset_ms) + ":" + String(ch.width_ms);
+  }
+  return result;
+}
+
+void print_outputs() {
+  Serial.println("=== Output Channels ===");
+  for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; i++) {
+    const OutputChannelConfig &ch = output_store.channels[i];
+    if (ch.type == OUTPUT_OFF) {
+      Serial.printf("%d: off\n", i);
+      continue;
+    }
+    Serial.printf("%d: %-5s pin %2d", i, ch.type == OUTPUT_SERVO ? "servo" : "opto", ch.pin);
+    if (ch.focus_pin >= 0) Serial.printf(" focus %2d", ch.focus_pin);
+    Serial.printf("  offset %4d ms  width %4d ms\n", ch.offset_ms, ch.width_ms);
+  }
+  Serial.print("Free pins:");
+  for (uint8_t i = 0; i < sizeof(output_free_pins); i++) Serial.printf(" %d", output_free_pins[i]);
+  Serial.println();
+  Serial.println("=======================");
+}
+
+#endif // OUTPUTS_H
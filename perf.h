@@ -0,0 +1,187 @@
+/*
+=============================================================================
+perf.h - Loop-Profiler: Zyklen je Stufe, gleitendes Histogramm
+=============================================================================
+Jede Stufe der UI-Loop (Serial, LVGL, Akku, BLE, Timer-UI, Encoder) und der
+Display-Flush werden mit dem CPU-Zyklenzähler gemessen. Je Stufe ein
+log-lineares Histogramm (4 Unterteilungen je Zweierpotenz, also max. 25 %
+Auflösungsfehler) mit 16-Bit-Zählern - ein Messpunkt kostet zwei
+Zählerlesungen, ein clz und ein paar Additionen, keine Division.
+
+Nach PERF_WINDOW_SAMPLES Messungen wird das Histogramm halbiert: Mittelwert
+und p99 gewichten so die jüngsten Durchläufe, ohne Ringpuffer. Min/Max
+gelten für die aktuelle und die vorige Epoche, peak seit "perf reset".
+
+Alle Stufen laufen im UI-Task - kein Lock nötig. my_disp_flush() wird aus
+lv_timer_handler() gerufen; die LVGL-Zeit enthält den Flush also schon.
+=============================================================================
+*/
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if defined(ESP32)
+#include "esp_cpu.h"
+#endif
+
+// =============================================================================
+// PROFILER CONFIGURATION
+// =============================================================================
+#define PERF_SUB_BITS           2                          // 4 Buckets je Zweierpotenz
+#define PERF_BUCKETS            ((33 - PERF_SUB_BITS) * (1 << PERF_SUB_BITS))   // bis 2^32 Zyklen
+
+enum PerfStage {
+  PERF_SERIAL,
+  PERF_LVGL,
+  PERF_BATTERY,
+  PERF_BLUETOOTH,
+  PERF_TIMER_UI,
+  PERF_ENCODER,
+  PERF_DISP_FLUSH,
+  PERF_STAGE_COUNT
+};
+
+struct PerfStageStats {
+  uint16_t buckets[PERF_BUCKETS];
+  uint32_t window_count;          // Summe der Buckets (nach Halbierung neu gezählt)
+  uint64_t window_cycles;         // Summe der Zyklen, mit den Buckets halbiert
+  uint32_t epoch_samples;         // Messungen seit der letzten Halbierung
+  uint32_t epoch_min, epoch_max;
+  uint32_t prev_min, prev_max;    // Vorige Epoche
+  uint32_t peak;                  // Max seit perf_reset()
+  uint32_t calls;                 // Seit perf_reset()
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+inline uint32_t perf_begin();                          // Zyklenzähler lesen
+inline void perf_end(uint8_t stage, uint32_t start);   // Dauer seit perf_begin() verbuchen
+void perf_record(uint8_t stage, uint32_t cycles);
+void perf_reset();
+void print_perf_report();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+PerfStageStats perf_stats[PERF_STAGE_COUNT];
+unsigned long perf_reset_at = 0;
+
+const char* const perf_stage_names[PERF_STAGE_COUNT] = {
+  "serial", "lvgl", "battery", "bluetooth", "timer_ui", "encoder", "disp_flush"
+};
+
+inline uint32_t perf_begin() {
+#if PERF_PROFILER_ENABLED
+#if defined(ESP32)
+  return esp_cpu_get_cycle_count();
+#else
+  return micros();
+#endif
+#else
+  return 0;
+#endif
+}
+
+inline void perf_end(uint8_t stage, uint32_t start) {
+#if PERF_PROFILER_ENABLED
+  perf_record(stage, perf_begin() - start);   // Modulo 2^32 - Überlauf des Zählers egal
+#endif
+}
+
+uint8_t perf_bucket(uint32_t cycles) {
+  if (cycles < (1 << PERF_SUB_BITS)) return cycles;
+  uint8_t msb = 31 - __builtin_clz(cycles);
+  uint8_t sub = (cycles >> (msb - PERF_SUB_BITS)) & ((1 << PERF_SUB_BITS) - 1);
+  return (msb - PERF_SUB_BITS + 1) * (1 << PERF_SUB_BITS) + sub;
+}
+
+uint64_t perf_bucket_floor(uint16_t bucket) {
+  if (bucket < (1 << PERF_SUB_BITS)) return bucket;
+  uint8_t msb = bucket / (1 << PERF_SUB_BITS) + PERF_SUB_BITS - 1;
+  uint8_t sub = bucket % (1 << PERF_SUB_BITS);
+  return (uint64_t)((1 << PERF_SUB_BITS) + sub) << (msb - PERF_SUB_BITS);
+}
+
+void perf_record(uint8_t stage, uint32_t cycles) {
+  PerfStageStats &s = perf_stats[stage];
+  s.buckets[perf_bucket(cycles)]++;
+  s.window_count++;
+  s.window_cycles += cycles;
+  s.calls++;
+  if (cycles < s.epoch_min) s.epoch_min = cycles;
+  if (cycles > s.epoch_max) s.epoch_max = cycles;
+  if (cycles > s.peak) s.peak = cycles;
+
+  if (++s.epoch_samples < PERF_WINDOW_SAMPLES) return;
+
+  // Epoche voll: ältere Messungen verlieren die Hälfte ihres Gewichts
+  s.window_count = 0;
+  for (uint16_t i = 0; i < PERF_BUCKETS; i++) {
+    s.buckets[i] >>= 1;
+    s.window_count += s.buckets[i];
+  }
+  s.window_cycles >>= 1;
+  s.prev_min = s.epoch_min;
+  s.prev_max = s.epoch_max;
+  s.epoch_min = UINT32_MAX;
+  s.epoch_max = 0;
+  s.epoch_samples = 0;
+}
+
+void perf_reset() {
+  memset(perf_stats, 0, sizeof(perf_stats));
+  for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+    perf_stats[i].epoch_min = UINT32_MAX;
+    perf_stats[i].prev_min = UINT32_MAX;
+  }
+  perf_reset_at = millis();
+}
+
+uint32_t perf_percentile(const PerfStageStats &s, uint32_t per_mille) {
+  uint32_t target = (uint32_t)(((uint64_t)s.window_count * per_mille + 999) / 1000);
+  uint32_t seen = 0;
+  for (uint16_t i = 0; i < PERF_BUCKETS; i++) {
+    seen += s.buckets[i];
+    if (seen >= target && seen > 0) {
+      // Obergrenze des Buckets - konservativ, aber nie über dem Maximum
+      uint64_t ceiling = perf_bucket_floor(i + 1) - 1;
+      return (uint32_t)min(ceiling, (uint64_t)max(s.epoch_max, s.prev_max));
+    }
+  }
+  return 0;
+}
+
+void print_perf_report() {
+#if defined(ESP32)
+  float cycles_per_us = getCpuFrequencyMhz();
+#else
+  float cycles_per_us = 1.0f;   // Host: perf_begin() liefert micros()
+#endif
+  Serial.println("=== Loop Profiler (us) ===");
+#if !PERF_PROFILER_ENABLED
+  Serial.println("Disabled (PERF_PROFILER_ENABLED)");
+#endif
+  Serial.printf("Window %d samples/stage, %lu s since reset\n", PERF_WINDOW_SAMPLES,
+                (unsigned long)((millis() - perf_reset_at) / 1000));
+  Serial.println("stage          calls      min     mean      p99      max     peak");
+  for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+    const PerfStageStats &s = perf_stats[i];
+    if (s.window_count == 0) {
+      Serial.printf("%-10s %9lu        -\n", perf_stage_names[i], (unsigned long)s.calls);
+      continue;
+    }
+    uint32_t low = min(s.epoch_min, s.prev_min);
+    uint32_t high = max(s.epoch_max, s.prev_max);
+    Serial.printf("%-10s %9lu %8.1f %8.1f %8.1f %8.1f %8.1f\n", perf_stage_names[i], (unsigned long)s.calls,
+                  low / cycles_per_us, (float)s.window_cycles / s.window_count / cycles_per_us,
+                  perf_percentile(s, 990) / cycles_per_us, high / cycles_per_us, s.peak / cycles_per_us);
+  }
+  Serial.println("lvgl includes disp_flush");
+  Serial.println("==========================");
+}
+
+#endif // PERF_H
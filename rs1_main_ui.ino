@@ -11,7 +11,12 @@ ESP32-C6 Camera Control App - Cleaned for Battery Debugging
 #include "ui.h"
 #include "battery.h"
 #include "timer_system.h"
+#include "checkpoint.h"
+#include "wall_clock.h"
+#include "time_sync.h"
 #include "bluetooth.h"
+#include "low_power.h"
+#include "tasks.h"
 
 // =============================================================================
 // ROTARY ENCODER HANDLING
@@ -21,6 +26,8 @@ void handle_encoder_input() {
   int32_t encoder_delta = get_adaptive_encoder_delta();
   
 if (encoder_delta != 0) {
+    low_power_note_activity();
+    
     // Handle encoder input based on current state
     if (app_state.current_state == STATE_INTERVAL) {
       // Interval page: always edit the single option (option 0)
@@ -54,11 +61,9 @@ if (encoder_delta != 0) {
       // GEÄNDERT: Immer speichern, unabhängig von settings_initialized
       static unsigned long last_wire_save = 0;
       if (millis() - last_wire_save > 1000) { // Max 1x pro Sekunde
-        preferences.begin(SETTINGS_NAMESPACE, false);
-        preferences.putInt(KEY_SERVO_WIRE_PCT, app_state.servo_wire_percentage);
-        preferences.end();
+        save_app_state();   // Schreibt der Housekeeping-Task
         last_wire_save = millis();
-        DEBUG_PRINTF("DIRECT SAVE: Wire percentage %d%% saved to flash\n", app_state.servo_wire_percentage);
+        DEBUG_PRINTF("Wire percentage %d%% queued for flash\n", app_state.servo_wire_percentage);
       }
     }
 
@@ -85,11 +90,16 @@ if (encoder_delta != 0) {
   // Check if encoder button was pressed (optional - for future use)
   if (is_encoder_button_pressed()) {
     DEBUG_PRINTLN("Encoder button pressed");
-    // Could be used to toggle between options manually
-    if (is_main_template_state(app_state.current_state) && app_state.current_state != STATE_INTERVAL) {
-      // Toggle between option 0 and 1 for Timer/T-Lapse
-      app_state.current_option = (app_state.current_option == 0) ? 1 : 0;
-      animate_to_option(app_state.current_option);
+    // Während T-Lapse/Interval: Pause/Resume wie der Button im Overlay
+    if (runtime.paused) {
+      resume_execution(app_state.resume_shift);
+    }
+    else if (run_pausable()) {
+      pause_execution();
+    }
+    else if (is_main_template_state(app_state.current_state) && app_state.current_state != STATE_INTERVAL) {
+      // Reihum durch die Karten (Timer 2, T-Lapse 3 mit Ramp)
+      animate_to_option((app_state.current_option + 1) % page_option_count(app_state.current_state));
       DEBUG_PRINTF("Encoder button: Switched to option %d\n", app_state.current_option);
     }
   }
@@ -97,15 +107,16 @@ if (encoder_delta != 0) {
 // =============================================================================
 // APPLICATION LOGIC
 // =============================================================================
-void app_init() {
-  Serial.println("=== ESP32-C6 Camera Control App ===");
-  Serial.println("Initializing application...");
-  
-  // Initialize subsystems in order
-  state_machine_init();
-  settings_init();
+void app_init_ui() {
+  // Cold-Path: Display, UI, Akku, BLE
   hardware_init();
   
+  // Fortgesetzter Lauf: ohne Loading Screen direkt auf die Seite des Laufs
+  if (timer_run_resumed && runtime.state != TIMER_IDLE) {
+    app_state.current_state = runtime.mode == TIMER_EXEC_MODE ? STATE_TIMER : 
+                              runtime.mode == TLAPSE_EXEC_MODE ? STATE_TLAPSE : STATE_INTERVAL;
+  }
+  
   bool charging = (digitalRead(CHARGE_PIN) == LOW);
   bool power_switch_on = (digitalRead(POWER_SWITCH_PIN) == HIGH);
   
@@ -125,14 +136,74 @@ void app_init() {
     }
     ui_init();
   }
+  if (timer_run_resumed && runtime.state != TIMER_IDLE) {
+    show_run_overlay();
+  }
+  wall_clock_init();
+  time_sync_init();
   bluetooth_init();
+  low_power_init();
+  
+  // Ab hier: loop() ist der UI-Task, Control und Housekeeping laufen daneben
+  tasks_start();
   
   Serial.println("=== Application Ready ===");
 }
 
+void app_init() {
+  Serial.println("=== ESP32-C6 Camera Control App ===");
+  Serial.println("Initializing application...");
+  
+  // Initialize subsystems in order
+  state_machine_init();
+  settings_init();
+  
+  // Timer-Wake aus dem Deep-Sleep: nur Frame feuern, kein UI/BLE (Hot-Path)
+  if (deep_sleep_resume() && deep_sleep_hot_path) {
+    Serial.println("=== Deep sleep hot path - UI stays off ===");
+    return;
+  }
+  // Reset mitten im Lauf (Brownout, Watchdog) - auf dem alten Raster weitermachen
+  if (!timer_run_resumed) {
+    checkpoint_resume();
+  }
+  app_init_ui();
+}
+
+void app_loop_hot() {
+  // Nach Timer-Wake: Scheduler bedienen, dann wieder in den Deep-Sleep
+  trigger_clock_lock();
+  dispatch_scheduled_events();
+  int frames = runtime.frameCount;
+  bool run_active = low_power_run_active();
+  trigger_clock_unlock();
+  
+  if (frames != timer_logged_frame_count) {
+    DEBUG_PRINTF("Frame %d triggered (deep sleep hot path)\n", frames);
+    timer_logged_frame_count = frames;
+  }
+  checkpoint_update();
+  
+  // Lauf zu Ende oder Bedienung -> volles UI hochfahren
+  if (!run_active || deep_sleep_input_seen()) {
+    Serial.println("Deep sleep hot path: bringing up the UI");
+    deep_sleep_hot_path = false;
+    app_init_ui();
+    return;
+  }
+  deep_sleep_idle();
+}
+
 void app_loop() {
-  // Handle LVGL tasks
-  lv_timer_handler();
+  if (deep_sleep_hot_path) {
+    app_loop_hot();
+    return;
+  }
+  
+  // Handle LVGL tasks - Rückgabe: ms bis zum nächsten fälligen LVGL-Timer
+  uint32_t perf_start = perf_begin();
+  uint32_t lvgl_wait_ms = lv_timer_handler();
+  perf_end(PERF_LVGL, perf_start);
   
   // Check if loading screen should timeout
   if (LOADING_SCREEN_ENABLED) {
@@ -147,22 +218,36 @@ void app_loop() {
     }
   }
   
-  // Battery System Updates (only if initialized)
-  static bool battery_system_active = false;
+  // Battery System Updates (only if initialized) - I2C liest der Housekeeping-Task
   if (app_state.current_state != STATE_LOADING || !LOADING_SCREEN_ENABLED) {
-    if (!battery_system_active) {
-      battery_system_active = true;
+    if (!tasks_battery_active) {
+      tasks_battery_active = true;
     }
+    perf_start = perf_begin();
     battery_system_update();
+    perf_end(PERF_BATTERY, perf_start);
   }
   
+  // Ohne eigene Tasks läuft deren Arbeit hier mit
+  if (!control_running()) timer_system_control_update();
+  if (!housekeeping_running()) checkpoint_update();
+  
   // Other systems
+  perf_start = perf_begin();
   bluetooth_update();
+  perf_end(PERF_BLUETOOTH, perf_start);
+  
+  perf_start = perf_begin();
   timer_system_update();
+  perf_end(PERF_TIMER_UI, perf_start);
   
+  perf_start = perf_begin();
   handle_encoder_input();
+  perf_end(PERF_ENCODER, perf_start);
 
-  delay(5);
+  // Während langer Läufe Light-Sleep bis kurz vor die nächste Deadline, sonst
+  // bis zum nächsten LVGL-Timer/Event warten (Encoder und BLE wecken vorzeitig)
+  low_power_idle(lvgl_wait_ms);
 }
 
 // =============================================================================
@@ -177,6 +262,119 @@ void handle_serial_commands() {
     if (command.startsWith("bat") || command.indexOf("battery") >= 0) {
       handle_battery_serial_commands(command);
     }
+    // Timer commands - route to timer_system.h
+    else if (command.startsWith("tlapse") || command == "frames" || command.startsWith("catchup") || 
+             command == "actuators" || command.startsWith("seq ") || command.startsWith("burst") || 
+             command.startsWith("focus") || command.startsWith("lag") || command.startsWith("output") ||
+             command.startsWith("ramp") || command == "pause" || command.startsWith("resume") ||
+             command == "ext" || command.startsWith("ext ")) {
+      handle_timer_serial_commands(command);
+    }
+    // Low-power run mode
+    else if (command.startsWith("power")) {
+      String arg = command.substring(5);
+      arg.trim();
+      if (arg == "on") set_low_power(true);
+      else if (arg == "off") set_low_power(false);
+      else if (arg == "deep on") set_deep_sleep(true);
+      else if (arg == "deep off") set_deep_sleep(false);
+      print_low_power_status();
+    }
+    // Wall clock + scheduled start
+    else if (command == "clock") {
+      print_wall_clock_status();
+    }
+    else if (command.startsWith("clock set ")) {
+      // clock set <epoch_ms> [tz_min]
+      String args = command.substring(10);
+      args.trim();
+      int space = args.indexOf(' ');
+      int64_t epoch_ms = strtoll(args.substring(0, space == -1 ? args.length() : space).c_str(), nullptr, 10);
+      long tz_min = space == -1 ? 0 : args.substring(space + 1).toInt();
+      if (epoch_ms <= 0 || tz_min < -14 * 60 || tz_min > 14 * 60) {
+        Serial.println("Clock: usage clock set <epoch_ms> [tz_min]");
+      } else {
+        wall_clock_set(epoch_ms * 1000, tz_min * 60);
+      }
+    }
+    else if (command.startsWith("at ")) {
+      // at <HH:MM[:SS]> <timer|tlapse|interval> - nächstes Auftreten dieser Lokalzeit
+      String args = command.substring(3);
+      args.trim();
+      int space = args.indexOf(' ');
+      String mode = space == -1 ? "" : args.substring(space + 1);
+      mode.trim();
+      uint32_t seconds_of_day;
+      int64_t start_us;
+      TimerExecutionMode exec_mode = mode == "timer" ? TIMER_EXEC_MODE : 
+                                     mode == "interval" ? INTERVAL_EXEC_MODE : TLAPSE_EXEC_MODE;
+      if (space == -1 || (mode != "timer" && mode != "tlapse" && mode != "interval") ||
+          !wall_clock_parse_time_of_day(args.substring(0, space), seconds_of_day)) {
+        Serial.println("At: usage at <HH:MM[:SS]> <timer|tlapse|interval>");
+      } else if (!wall_clock_next_time_of_day(seconds_of_day, start_us)) {
+        Serial.println("At: wall clock not set - use 'clock set' or BLE CLOCK:");
+      } else if (!wall_clock_start_at(start_us, exec_mode)) {
+        Serial.println("At: not armed (another run active or settings rejected)");
+      }
+    }
+    // Multi-device time sync - Host am USB-Serial als Master
+    else if (command == "sync") {
+      print_time_sync_status();
+    }
+    else if (command == "sync start") {
+      Serial.println("SYNC_REQ:" + time_sync_int64(time_sync_begin()));
+    }
+    else if (command == "sync reset") {
+      time_sync_reset();
+    }
+    else if (command.startsWith("sync at ")) {
+      // sync at <master_us> <timer|tlapse|interval>
+      String args = command.substring(8);
+      args.trim();
+      int space = args.indexOf(' ');
+      String mode = space == -1 ? "" : args.substring(space + 1);
+      mode.trim();
+      int64_t master_us = strtoll(args.substring(0, space == -1 ? args.length() : space).c_str(), nullptr, 10);
+      if (master_us <= 0 || (mode != "timer" && mode != "tlapse" && mode != "interval")) {
+        Serial.println("Sync: usage sync at <master_us> <timer|tlapse|interval>");
+      } else if (!time_sync_start_at(master_us, mode == "timer" ? TIMER_EXEC_MODE :
+                                     mode == "interval" ? INTERVAL_EXEC_MODE : TLAPSE_EXEC_MODE)) {
+        Serial.println("Sync: not armed (not synced, time passed or another run active)");
+      }
+    }
+    else if (command.startsWith("sync ")) {
+      // sync <t1> <t2> <t3> - Antwort des Masters auf SYNC_REQ:<t1>
+      uint64_t t4 = trigger_clock_now_us();
+      String args = command.substring(5);
+      int first = args.indexOf(' ');
+      int second = args.indexOf(' ', first + 1);
+      if (first == -1 || second == -1) {
+        Serial.println("Sync: usage sync <t1> <t2> <t3>");
+      } else {
+        uint8_t result = time_sync_sample(strtoull(args.substring(0, first).c_str(), nullptr, 10),
+                                          strtoll(args.substring(first + 1, second).c_str(), nullptr, 10),
+                                          strtoll(args.substring(second + 1).c_str(), nullptr, 10), t4);
+        if (result == TIMESYNC_NEXT) Serial.println("SYNC_REQ:" + time_sync_int64(time_sync_next_request()));
+        else if (result == TIMESYNC_DONE) Serial.println("SYNCED:" + time_sync_status_string());
+        else Serial.println("Sync: sample rejected");
+      }
+    }
+    // Run checkpoint (resume after brownout/watchdog)
+    else if (command == "checkpoint") {
+      print_checkpoint_status();
+    }
+    // Control/UI/Housekeeping tasks
+    else if (command == "tasks") {
+      print_task_status();
+    }
+    // Loop-Profiler
+    else if (command == "perf") {
+      print_perf_report();
+    }
+    else if (command == "perf reset") {
+      perf_reset();
+      Serial.println("Profiler reset");
+    }
     // Direct pin testing
     else if (command == "pintest") {
       bool charging = digitalRead(3) == LOW;  
@@ -223,6 +421,32 @@ void handle_serial_commands() {
       Serial.println("statetest - Show battery system state");
       Serial.println("bat status - Full battery status");
       Serial.println("bat pins  - Battery pin readings");
+      Serial.println("tlapse plan [n] - Planned T-Lapse frame timestamps");
+      Serial.println("frames    - Planned vs actual frame log");
+      Serial.println("catchup [skip|fire|shift] - Missed-frame policy");
+      Serial.println("actuators - Output busy windows and max frame rates");
+      Serial.println("seq run <program> - Run a sequence (D<ms>,B<n>@<ms>,I<n>@<ms>,S<n>/<ms>,R<n>@<ms>-<ms>,*<r>)");
+      Serial.println("seq show  - Compiled ops of the last program");
+      Serial.println("ramp [curve <L|I|O|S>|run <s>@<ms>,...] - T-Lapse interval ramp (keyframes)");
+      Serial.println("pause / resume [grid|shift] - Pause a T-Lapse/Interval, resume on the old grid or shifted");
+      Serial.println("resume default <grid|shift> - Resume mode for the overlay button and encoder");
+      Serial.println("focus [on|off|lead <ms>|dur <ms>] - Focus/wake pulse before every frame");
+      Serial.println("lag [use <i>|set <i> <ms> [name]|measure] - Camera shutter-lag profiles");
+      Serial.println("outputs   - Output channels (multi-camera rigs)");
+      Serial.println("output <n> off|servo <pin>|opto <pin> [focus]|time <offset> <width> - Configure a channel");
+      Serial.println("burst     - Fire the configured elektro release burst");
+      Serial.println("burst set <n> <hz> <ms> - Burst pulses, rate (max 20 Hz), pulse width");
+      Serial.println("ext [arm|fire] - External trigger input (Interval EXT), latency stats, test edge");
+      Serial.println("ext delay <ms> | lockout <ms> | servo <on|off> - External trigger settings");
+      Serial.println("power [on|off] - Light sleep between frames, wake overhead stats");
+      Serial.println("power deep [on|off] - Deep sleep with RTC-kept run state on long gaps");
+      Serial.println("checkpoint - Run checkpoint status (resume after reset)");
+      Serial.println("tasks     - Control/UI/housekeeping tasks, stack and queue usage");
+      Serial.println("perf [reset] - Loop profiler: min/mean/p99/max per stage in us");
+      Serial.println("clock [set <epoch_ms> [tz_min]] - Wall clock and RTC drift calibration");
+      Serial.println("at <HH:MM[:SS]> <timer|tlapse|interval> - Arm the page's run for a time of day");
+      Serial.println("sync [start|reset] - Time sync against a master (reply: sync <t1> <t2> <t3>)");
+      Serial.println("sync at <master_us> <timer|tlapse|interval> - Arm a run at a master time");
       Serial.println("skip      - Skip loading screen");
       Serial.println("======================");
     }
@@ -250,6 +474,7 @@ void setup() {
     DEBUG_PRINTLN("Loading screen: DISABLED (debug mode)");
   }
 
+  perf_reset();
   app_init();
   
   Serial.println("=== Setup Complete ===");
@@ -257,6 +482,8 @@ void setup() {
 }
 
 void loop() {
+  uint32_t perf_start = perf_begin();
   handle_serial_commands();
+  perf_end(PERF_SERIAL, perf_start);
   app_loop();
 }
\ No newline at end of file
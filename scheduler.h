@@ -0,0 +1,244 @@
+/*
+=============================================================================
+scheduler.h - Absolute-Deadline Event Queue for Timer/T-Lapse/Interval
+=============================================================================
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+#include "config.h"
+#include "trigger_clock.h"
+
+// =============================================================================
+// SCHEDULER CONFIGURATION
+// =============================================================================
+#define SCHEDULER_QUEUE_SIZE 32   // Max. gleichzeitig geplante Events (je Frame bis zu 3 pro Ausgabekanal)
+
+// Event-Typen - jeder Eintrag ist eine Flanke mit absoluter Deadline
+enum ScheduledEventType {
+  EVENT_FOCUS_START,      // Fokus-Optokoppler EIN
+  EVENT_FOCUS_END,        // Fokus-Optokoppler AUS
+  EVENT_RELEASE_START,    // Frame / Auslösung des aktiven Modus
+  EVENT_RELEASE_END,      // Release-Optokoppler AUS (bzw. Bulb-Ende)
+  EVENT_SERVO_RETURN,     // Servo zurück auf Startposition
+  EVENT_COMPLETE,         // Completion-Timeout des Laufs
+  EVENT_ACTUATOR_READY,   // Ein Ausgabekanal ist wieder frei (wartende Auslösung)
+  EVENT_CHANNEL_FIRE,     // Versetzte Auslösung eines Ausgabekanals (outputs.h)
+  EVENT_CHANNEL_END       // Zusatzkanal AUS (Impuls- bzw. Servo-Haltezeit vorbei)
+};
+
+struct ScheduledEvent {
+  uint64_t deadline;        // Absolute Zeit in µs (trigger_clock_now_us)
+  uint16_t sequence;        // FIFO-Reihenfolge bei gleicher Deadline
+  uint8_t type;             // ScheduledEventType
+  uint8_t channel;          // Ausgabekanal (EVENT_CHANNEL_*)
+};
+
+// Binärer Min-Heap, sortiert nach Deadline
+struct SchedulerQueue {
+  ScheduledEvent events[SCHEDULER_QUEUE_SIZE];
+  uint8_t count;
+  uint16_t next_sequence;
+};
+
+// Frame-Plan: verteilt N Frames ganzzahlig über die Gesamtdauer (Bresenham).
+// Frame k liegt exakt bei floor(k * total_ms / frames) - ohne Fehlerakkumulation.
+struct FramePlan {
+  unsigned long total_ms;
+  uint32_t frames;
+  unsigned long step_ms;      // total_ms / frames
+  uint32_t step_remainder;    // total_ms % frames
+  uint32_t error;             // Bresenham-Akkumulator (immer < frames)
+  uint32_t index;             // Zuletzt geplanter Frame (0 = noch keiner)
+  unsigned long offset_ms;    // Offset des zuletzt geplanten Frames ab Start
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void scheduler_init();
+void scheduler_clear();
+bool scheduler_push(uint8_t type, uint64_t deadline, uint8_t channel = 0);
+void scheduler_remove(uint8_t type);
+bool scheduler_pop_due(uint64_t now, ScheduledEvent &event);
+bool scheduler_next_deadline(uint64_t &deadline);
+uint8_t scheduler_count();
+void scheduler_rearm();   // One-Shot-Uhr auf den Queue-Kopf stellen
+
+// true wenn 'deadline' erreicht ist (64-Bit-µs laufen nicht über)
+bool time_reached(uint64_t now, uint64_t deadline);
+
+// Frame-Planung
+void frame_plan_init(FramePlan &plan, unsigned long total_ms, uint32_t frames);
+bool frame_plan_next(FramePlan &plan, unsigned long &offset_ms);
+unsigned long frame_plan_offset(const FramePlan &plan, uint32_t frame);
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+SchedulerQueue scheduler_queue;
+
+bool time_reached(uint64_t now, uint64_t deadline) {
+  return now >= deadline;
+}
+
+// Heap-Ordnung: frühere Deadline zuerst, bei Gleichstand die ältere Einplanung
+bool scheduler_event_before(const ScheduledEvent &a, const ScheduledEvent &b) {
+  if (a.deadline != b.deadline) return a.deadline < b.deadline;
+  return (int16_t)(a.sequence - b.sequence) < 0;
+}
+
+void scheduler_sift_up(uint8_t index) {
+  while (index > 0) {
+    uint8_t parent = (index - 1) / 2;
+    if (!scheduler_event_before(scheduler_queue.events[index], scheduler_queue.events[parent])) break;
+    ScheduledEvent tmp = scheduler_queue.events[parent];
+    scheduler_queue.events[parent] = scheduler_queue.events[index];
+    scheduler_queue.events[index] = tmp;
+    index = parent;
+  }
+}
+
+void scheduler_sift_down(uint8_t index) {
+  while (true) {
+    uint8_t left = index * 2 + 1;
+    uint8_t right = left + 1;
+    uint8_t smallest = index;
+
+    if (left < scheduler_queue.count &&
+        scheduler_event_before(scheduler_queue.events[left], scheduler_queue.events[smallest])) {
+      smallest = left;
+    }
+    if (right < scheduler_queue.count &&
+        scheduler_event_before(scheduler_queue.events[right], scheduler_queue.events[smallest])) {
+      smallest = right;
+    }
+    if (smallest == index) break;
+
+    ScheduledEvent tmp = scheduler_queue.events[smallest];
+    scheduler_queue.events[smallest] = scheduler_queue.events[index];
+    scheduler_queue.events[index] = tmp;
+    index = smallest;
+  }
+}
+
+void scheduler_init() {
+  scheduler_clear();
+  DEBUG_PRINTF("Scheduler initialized (%d slots)\n", SCHEDULER_QUEUE_SIZE);
+}
+
+void scheduler_clear() {
+  scheduler_queue.count = 0;
+  scheduler_queue.next_sequence = 0;
+  trigger_clock_disarm();
+}
+
+bool scheduler_push(uint8_t type, uint64_t deadline, uint8_t channel) {
+  if (scheduler_queue.count >= SCHEDULER_QUEUE_SIZE) {
+    DEBUG_PRINTF("ERROR: Scheduler queue full - event %d dropped\n", type);
+    return false;
+  }
+
+  uint8_t index = scheduler_queue.count++;
+  scheduler_queue.events[index].deadline = deadline;
+  scheduler_queue.events[index].sequence = scheduler_queue.next_sequence++;
+  scheduler_queue.events[index].type = type;
+  scheduler_queue.events[index].channel = channel;
+  scheduler_sift_up(index);
+  
+  // Neuer Kopf -> Hardware-Uhr nachstellen
+  if (scheduler_queue.events[0].sequence == (uint16_t)(scheduler_queue.next_sequence - 1)) {
+    trigger_clock_arm(deadline);
+  }
+  return true;
+}
+
+void scheduler_remove(uint8_t type) {
+  // Selten benutzt (Fokus neu planen) - einfach kompaktieren und Heap neu aufbauen
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < scheduler_queue.count; i++) {
+    if (scheduler_queue.events[i].type != type) {
+      scheduler_queue.events[kept++] = scheduler_queue.events[i];
+    }
+  }
+  scheduler_queue.count = kept;
+
+  for (int i = (int)kept / 2 - 1; i >= 0; i--) {
+    scheduler_sift_down(i);
+  }
+  scheduler_rearm();
+}
+
+bool scheduler_pop_due(uint64_t now, ScheduledEvent &event) {
+  // Nur der Kopf der Queue wird geprüft
+  if (scheduler_queue.count == 0) return false;
+  if (!time_reached(now, scheduler_queue.events[0].deadline)) return false;
+
+  event = scheduler_queue.events[0];
+  scheduler_queue.count--;
+  if (scheduler_queue.count > 0) {
+    scheduler_queue.events[0] = scheduler_queue.events[scheduler_queue.count];
+    scheduler_sift_down(0);
+  }
+  return true;
+}
+
+bool scheduler_next_deadline(uint64_t &deadline) {
+  if (scheduler_queue.count == 0) return false;
+  deadline = scheduler_queue.events[0].deadline;
+  return true;
+}
+
+uint8_t scheduler_count() {
+  return scheduler_queue.count;
+}
+
+void scheduler_rearm() {
+  if (scheduler_queue.count > 0) {
+    trigger_clock_arm(scheduler_queue.events[0].deadline);
+  } else {
+    trigger_clock_disarm();
+  }
+}
+
+// =============================================================================
+// FRAME PLANNING - Bresenham-Verteilung in ganzen Millisekunden
+// =============================================================================
+void frame_plan_init(FramePlan &plan, unsigned long total_ms, uint32_t frames) {
+  plan.total_ms = total_ms;
+  plan.frames = frames;
+  plan.step_ms = (frames > 0) ? total_ms / frames : 0;
+  plan.step_remainder = (frames > 0) ? total_ms % frames : 0;
+  plan.error = 0;
+  plan.index = 0;
+  plan.offset_ms = 0;
+}
+
+bool frame_plan_next(FramePlan &plan, unsigned long &offset_ms) {
+  if (plan.index >= plan.frames) return false;
+
+  // Ganzzahliger Schritt + Rest verteilen: Abstände sind step_ms oder step_ms + 1
+  plan.index++;
+  plan.offset_ms += plan.step_ms;
+  plan.error += plan.step_remainder;
+  if (plan.error >= plan.frames) {
+    plan.error -= plan.frames;
+    plan.offset_ms++;
+  }
+
+  offset_ms = plan.offset_ms;
+  return true;
+}
+
+unsigned long frame_plan_offset(const FramePlan &plan, uint32_t frame) {
+  // Geschlossene Form für die Ausgabe einzelner Frames (1-basiert)
+  if (plan.frames == 0) return 0;
+  if (frame > plan.frames) frame = plan.frames;
+  return (unsigned long)(((uint64_t)frame * plan.total_ms) / plan.frames);
+}
+
+#endif // SCHEDULER_H
@@ -0,0 +1,725 @@
+/*
+=============================================================================
+sequence.h - Sequenzprogramme für Timer/T-Lapse/Interval und Multi-Stage
+=============================================================================
+Ein Programm besteht aus Segmenten (Delay, Burst, Interval, Spread, Ramp) mit
+Wiederholungszahl. Beim Start wird es einmal in ein flaches Op-Array
+übersetzt. sequence_next() läuft dieses Array ganzzahlig ab und liefert die
+nächste Aktion (Frame oder Ende) mit ihrer Programmzeit - jeder Schritt ist O(1).
+Die Ausführung (Deadlines, Auslösung, Catch-up) liegt in timer_system.h.
+
+Textformat (Serial "seq run ..." / BLE "SEQ:..."), Segmente mit ',' getrennt:
+  D<ms>                 Pause
+  B<n>@<ms>             Burst: n Frames im Abstand ms (erster sofort)
+  I<n>@<ms>             Interval: n Frames, jeweils nach ms (n = 0: endlos)
+  S<n>/<ms>             Spread: n Frames gleichmäßig über ms verteilt (T-Lapse)
+  R<n>@<ms>-<ms>[~<c>]  Ramp: n Frames, Abstand von ms bis ms, Kurve c = L/I/O/S
+                        (linear, ease-in, ease-out, ease-in-out; Standard L)
+  Suffix *<r>           Segment r-mal wiederholen
+Beispiel: D5000,B5@200*3,I0@10000
+Zahlen sind nicht-negative Ganzzahlen: ms bis VALUE_MAX_DURATION_S (30 Tage),
+n bis SEQUENCE_MAX_FRAMES, r bis 65535 - alles andere lehnt der Parser ab.
+
+Keyframe-Rampen (T-Lapse, Serial "ramp run ..." / BLE "RAMP:..."):
+  <s>@<ms>,<s>@<ms>,... Zum Zeitpunkt s (ab Start) beträgt der Abstand ms
+Jedes Keyframe-Paar wird zu einem Ramp-Segment, dessen Frame-Zahl einmal
+beim Start aus Dauer und mittlerem Abstand der Kurve berechnet wird.
+=============================================================================
+*/
+
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =============================================================================
+// SEQUENCE CONFIGURATION
+// =============================================================================
+#define SEQUENCE_MAX_SEGMENTS   8
+#define SEQUENCE_MAX_OPS        40
+#define SEQUENCE_STEP_BUDGET    64    // Max. Ops pro sequence_next()-Aufruf
+#define RAMP_MAX_KEYFRAMES      6     // -> max. 5 Ramp-Segmente
+#define SEQUENCE_MAX_FRAMES     1000000   // Frames je Segment-Durchlauf (Parser)
+#define SEQUENCE_MAX_MS         ((uint32_t)VALUE_MAX_DURATION_S * 1000)   // Längste Pause/Abstand (Parser)
+
+enum SequenceSegmentType {
+  SEG_DELAY,      // Pause
+  SEG_BURST,      // Frame, Abstand, Frame, ...
+  SEG_INTERVAL,   // Abstand, Frame, Abstand, Frame, ...
+  SEG_SPREAD,     // Wie Interval, Abstände per Bresenham aus Gesamtdauer
+  SEG_RAMP        // Wie Interval, Abstand entlang einer Kurve interpoliert
+};
+
+// Verlauf des Abstands innerhalb eines Ramp-Segments
+enum RampCurve {
+  RAMP_LINEAR,
+  RAMP_EASE_IN,       // Erst langsam, dann schnell ändern (u²)
+  RAMP_EASE_OUT,      // Erst schnell, dann langsam ändern (1-(1-u)²)
+  RAMP_EASE_IN_OUT    // Smoothstep (3u²-2u³)
+};
+
+struct SequenceSegment {
+  uint8_t type;
+  uint16_t repeat;        // Durchläufe des Segments (1 = einmal)
+  uint32_t count;         // Frames pro Durchlauf (INTERVAL: 0 = endlos)
+  uint32_t period_ms;     // DELAY: Dauer, BURST/INTERVAL: Abstand, SPREAD: Gesamtdauer, RAMP: Startabstand
+  uint32_t end_ms;        // RAMP: Endabstand
+  uint32_t hold_ms;       // Frame: 0 = Trigger, > 0 = Bulb mit dieser Haltezeit
+  uint32_t focus_ms;      // Fokus-Vorlauf vor jedem Frame (0 = aus)
+  uint32_t pulse_ms;      // > 0: nur Elektro-Release mit dieser Pulsbreite (Burst)
+  uint8_t curve;          // RAMP: RampCurve
+};
+
+struct SequenceProgram {
+  SequenceSegment segments[SEQUENCE_MAX_SEGMENTS];
+  uint8_t count;
+};
+
+// Flaches Op-Array - Ergebnis der Übersetzung
+enum SequenceOpCode {
+  SEQ_OP_END,
+  SEQ_OP_WAIT,          // a = ms
+  SEQ_OP_WAIT_SPREAD,   // a = Gesamtdauer, b = Frames; Schritt k aus Schleife 'loop'
+  SEQ_OP_WAIT_RAMP,     // a = Startabstand, b = Endabstand, c = Frames, curve; Schritt k aus 'loop'
+  SEQ_OP_FRAME,         // a = Haltezeit (0 = Trigger), b = Fokus-Vorlauf, c = Elektro-Pulsbreite
+  SEQ_OP_LOOP           // a = Sprungziel, b = Durchläufe (0 = endlos)
+};
+
+struct SequenceOp {
+  uint8_t code;
+  uint8_t loop;         // Index der umgebenden LOOP-Op (für WAIT_SPREAD/WAIT_RAMP)
+  uint8_t curve;        // WAIT_RAMP: RampCurve
+  uint32_t a;
+  uint32_t b;
+  uint32_t c;
+};
+
+struct SequenceCode {
+  SequenceOp ops[SEQUENCE_MAX_OPS];
+  uint8_t count;
+};
+
+// Laufzeitzustand beim Abarbeiten
+struct SequenceVM {
+  uint8_t pc;
+  uint64_t clock_ms;                      // Programmzeit seit Start (endlose Läufe > 49 Tage)
+  uint32_t frame_index;                   // Zuletzt gelieferter Frame (1-basiert)
+  uint32_t counters[SEQUENCE_MAX_OPS];    // Schleifenzähler je LOOP-Op
+};
+
+enum SequenceActionType {
+  SEQ_ACTION_FRAME,
+  SEQ_ACTION_END,
+  SEQ_ACTION_CONTINUE   // Budget erschöpft - später weiterlaufen
+};
+
+struct SequenceAction {
+  uint8_t type;
+  uint64_t at_ms;         // Programmzeit der Aktion
+  uint32_t frame;         // Frame-Index (1-basiert)
+  uint32_t hold_ms;
+  uint32_t focus_ms;
+  uint32_t pulse_ms;
+};
+
+// Keyframe-Rampe: Abstand interval_ms zum Zeitpunkt at_s nach dem Start
+struct RampKeyframe {
+  uint32_t at_s;
+  uint32_t interval_ms;
+};
+
+struct RampPlan {
+  RampKeyframe keys[RAMP_MAX_KEYFRAMES];
+  uint8_t count;
+  uint8_t curve;          // RampCurve für alle Abschnitte
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void sequence_clear(SequenceProgram &program);
+bool sequence_add(SequenceProgram &program, uint8_t type, uint32_t count, uint32_t period_ms,
+                  uint32_t end_ms = 0, uint16_t repeat = 1);
+bool sequence_compile(const SequenceProgram &program, SequenceCode &code);
+void sequence_reset(SequenceVM &vm);
+bool sequence_next(const SequenceCode &code, SequenceVM &vm, SequenceAction &action);
+
+// Kennzahlen für Rate-Prüfung und Anzeige
+uint32_t sequence_segment_frames(const SequenceSegment &seg);    // count * repeat, gesättigt
+uint32_t sequence_total_frames(const SequenceProgram &program);   // 0 = endlos
+uint32_t sequence_min_frame_spacing(const SequenceProgram &program);
+
+// Presets der drei Modi
+void sequence_preset_timer(SequenceProgram &program, uint32_t delay_ms, uint32_t hold_ms, uint32_t focus_ms);
+void sequence_preset_tlapse(SequenceProgram &program, uint32_t total_ms, uint32_t frames);
+void sequence_preset_interval(SequenceProgram &program, uint32_t interval_ms);
+void sequence_preset_burst(SequenceProgram &program, uint32_t count, uint32_t period_ms, uint32_t pulse_ms);
+void sequence_set_focus(SequenceProgram &program, uint32_t focus_ms);   // Fokus-Vorlauf für alle Frames
+
+// Keyframe-Rampen
+uint32_t ramp_curve_q16(uint8_t curve, uint32_t u);   // u, Ergebnis in Q16 (0..65536)
+uint32_t ramp_curve_mean_q16(uint8_t curve);          // Mittelwert der Kurve über 0..1
+uint32_t ramp_step_ms(uint32_t start_ms, uint32_t end_ms, uint32_t frames, uint8_t curve, uint32_t k);
+uint64_t ramp_duration_ms(uint32_t start_ms, uint32_t end_ms, uint32_t frames, uint8_t curve);
+bool ramp_plan_valid(const RampPlan &plan);
+bool sequence_preset_ramp(SequenceProgram &program, const RampPlan &plan);
+bool ramp_parse(String text, RampPlan &plan);         // "<s>@<ms>,<s>@<ms>,..."
+int ramp_curve_from_char(char c);                     // L/I/O/S -> RampCurve, -1 = ungültig
+const char* ramp_curve_name(uint8_t curve);
+String ramp_plan_string(const RampPlan &plan);
+
+// Textformat
+bool sequence_parse(String text, SequenceProgram &program);
+bool sequence_parse_value(String text, uint32_t max_value, uint32_t &value);   // Nur Ziffern, 0..max
+void sequence_print(const SequenceCode &code);
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+void sequence_clear(SequenceProgram &program) {
+  program.count = 0;
+}
+
+bool sequence_add(SequenceProgram &program, uint8_t type, uint32_t count, uint32_t period_ms,
+                  uint32_t end_ms, uint16_t repeat) {
+  if (program.count >= SEQUENCE_MAX_SEGMENTS) {
+    DEBUG_PRINTLN("ERROR: Sequence has too many segments");
+    return false;
+  }
+
+  SequenceSegment &segment = program.segments[program.count++];
+  segment.type = type;
+  segment.repeat = repeat > 0 ? repeat : 1;
+  segment.count = count;
+  segment.period_ms = period_ms;
+  segment.end_ms = end_ms;
+  segment.hold_ms = 0;
+  segment.focus_ms = 0;
+  segment.pulse_ms = 0;
+  segment.curve = RAMP_LINEAR;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Compiler
+// -----------------------------------------------------------------------------
+bool sequence_emit(SequenceCode &code, uint8_t op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0) {
+  if (code.count >= SEQUENCE_MAX_OPS) return false;
+  SequenceOp &entry = code.ops[code.count++];
+  entry.code = op;
+  entry.loop = 0;
+  entry.curve = RAMP_LINEAR;
+  entry.a = a;
+  entry.b = b;
+  entry.c = c;
+  return true;
+}
+
+bool sequence_compile_segment(const SequenceSegment &seg, SequenceCode &code) {
+  uint8_t segment_start = code.count;
+
+  if (seg.type == SEG_DELAY) {
+    // Wiederholte Pause = eine lange Pause, solange sie in 32 Bit passt - sonst Schleife um eine Pause
+    if (seg.period_ms == 0) return true;
+    uint64_t total_ms = (uint64_t)seg.period_ms * max(seg.repeat, (uint16_t)1);
+    if (total_ms <= UINT32_MAX) return sequence_emit(code, SEQ_OP_WAIT, (uint32_t)total_ms);
+    return sequence_emit(code, SEQ_OP_WAIT, seg.period_ms) &&
+           sequence_emit(code, SEQ_OP_LOOP, segment_start, seg.repeat);
+  }
+
+  if (seg.count == 0) {
+    if (seg.type != SEG_INTERVAL) return true;   // Leeres Segment
+    if (seg.period_ms == 0) {
+      DEBUG_PRINTLN("ERROR: Endless interval needs a period > 0");
+      return false;
+    }
+  }
+
+  uint8_t wait_index = 0xFF;
+  bool ok;
+
+  if (seg.type == SEG_BURST) {
+    ok = sequence_emit(code, SEQ_OP_FRAME, seg.hold_ms, seg.focus_ms, seg.pulse_ms);
+    if (ok && seg.period_ms > 0) ok = sequence_emit(code, SEQ_OP_WAIT, seg.period_ms);
+  } else {
+    switch (seg.type) {
+      case SEG_INTERVAL: ok = sequence_emit(code, SEQ_OP_WAIT, seg.period_ms); break;
+      case SEG_SPREAD:   ok = sequence_emit(code, SEQ_OP_WAIT_SPREAD, seg.period_ms, seg.count); break;
+      case SEG_RAMP:     
+        ok = sequence_emit(code, SEQ_OP_WAIT_RAMP, seg.period_ms, seg.end_ms, seg.count);
+        if (ok) code.ops[code.count - 1].curve = seg.curve;
+        break;
+      default:
+        DEBUG_PRINTF("ERROR: Unknown sequence segment type %d\n", seg.type);
+        return false;
+    }
+    wait_index = code.count - 1;
+    if (ok) ok = sequence_emit(code, SEQ_OP_FRAME, seg.hold_ms, seg.focus_ms, seg.pulse_ms);
+  }
+  if (!ok) return false;
+
+  if (seg.count != 1) {
+    // Innere Schleife über die Frames - ihr Zähler liefert Schritt k für SPREAD/RAMP
+    if (!sequence_emit(code, SEQ_OP_LOOP, segment_start, seg.count)) return false;
+    if (wait_index != 0xFF) code.ops[wait_index].loop = code.count - 1;
+  } else if (wait_index != 0xFF) {
+    // Einzelner Frame: Schritt k ist immer 1 -> feste Pause
+    code.ops[wait_index].code = SEQ_OP_WAIT;
+    code.ops[wait_index].a = seg.period_ms;
+  }
+
+  // Äußere Schleife für Segment-Wiederholungen
+  return seg.repeat <= 1 || sequence_emit(code, SEQ_OP_LOOP, segment_start, seg.repeat);
+}
+
+bool sequence_compile(const SequenceProgram &program, SequenceCode &code) {
+  code.count = 0;
+
+  for (uint8_t s = 0; s < program.count; s++) {
+    if (!sequence_compile_segment(program.segments[s], code)) {
+      DEBUG_PRINTF("ERROR: Sequence segment %d could not be compiled (max %d ops)\n", s + 1, SEQUENCE_MAX_OPS);
+      code.count = 0;
+      return false;
+    }
+  }
+
+  if (!sequence_emit(code, SEQ_OP_END)) {
+    DEBUG_PRINTF("ERROR: Sequence needs more than %d ops\n", SEQUENCE_MAX_OPS);
+    code.count = 0;
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Interpreter - ganzzahlig, keine Fließkomma-Rechnung pro Schritt
+// -----------------------------------------------------------------------------
+void sequence_reset(SequenceVM &vm) {
+  vm.pc = 0;
+  vm.clock_ms = 0;
+  vm.frame_index = 0;
+  memset(vm.counters, 0, sizeof(vm.counters));
+}
+
+bool sequence_next(const SequenceCode &code, SequenceVM &vm, SequenceAction &action) {
+  for (int budget = 0; budget < SEQUENCE_STEP_BUDGET; budget++) {
+    if (vm.pc >= code.count) {
+      action.type = SEQ_ACTION_END;
+      action.at_ms = vm.clock_ms;
+      return true;
+    }
+
+    const SequenceOp &op = code.ops[vm.pc];
+    switch (op.code) {
+      case SEQ_OP_WAIT:
+        vm.clock_ms += op.a;
+        vm.pc++;
+        break;
+
+      case SEQ_OP_WAIT_SPREAD: {
+        // Abstand k = floor(k*T/N) - floor((k-1)*T/N) -> Summe exakt T
+        uint64_t k = vm.counters[op.loop] + 1;
+        vm.clock_ms += (k * op.a) / op.b - ((k - 1) * op.a) / op.b;
+        vm.pc++;
+        break;
+      }
+
+      case SEQ_OP_WAIT_RAMP:
+        // Abstand k direkt aus k - kein Aufsummieren, kein Lösen der Kurve
+        vm.clock_ms += ramp_step_ms(op.a, op.b, op.c, op.curve, vm.counters[op.loop] + 1);
+        vm.pc++;
+        break;
+
+      case SEQ_OP_LOOP:
+        vm.counters[vm.pc]++;
+        if (op.b == 0 || vm.counters[vm.pc] < op.b) {
+          vm.pc = op.a;
+        } else {
+          vm.counters[vm.pc] = 0;
+          vm.pc++;
+        }
+        break;
+
+      case SEQ_OP_FRAME:
+        vm.frame_index++;
+        vm.pc++;
+        action.type = SEQ_ACTION_FRAME;
+        action.at_ms = vm.clock_ms;
+        action.frame = vm.frame_index;
+        action.hold_ms = op.a;
+        action.focus_ms = op.b;
+        action.pulse_ms = op.c;
+        return true;
+
+      default:   // SEQ_OP_END
+        action.type = SEQ_ACTION_END;
+        action.at_ms = vm.clock_ms;
+        return true;
+    }
+  }
+
+  action.type = SEQ_ACTION_CONTINUE;
+  action.at_ms = vm.clock_ms;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Kennzahlen
+// -----------------------------------------------------------------------------
+uint32_t sequence_segment_frames(const SequenceSegment &seg) {
+  // count * repeat in 64 Bit - ein Überlauf auf 0 sähe wie "kein Frame"/"endlos" aus
+  uint64_t frames = (uint64_t)seg.count * seg.repeat;
+  return frames > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)frames;
+}
+
+uint32_t sequence_total_frames(const SequenceProgram &program) {
+  uint64_t total = 0;
+  for (uint8_t s = 0; s < program.count; s++) {
+    const SequenceSegment &seg = program.segments[s];
+    if (seg.type == SEG_DELAY) continue;
+    if (seg.count == 0 && seg.type == SEG_INTERVAL) return 0;
+    total += sequence_segment_frames(seg);
+  }
+  return total > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)total;
+}
+
+uint32_t sequence_min_frame_spacing(const SequenceProgram &program) {
+  // Kleinster Abstand zweier Frames - innerhalb eines Segments und über
+  // Segmentgrenzen hinweg (0xFFFFFFFF = keiner)
+  uint32_t spacing = 0xFFFFFFFF;
+  bool have_frame = false;
+  uint64_t gap_ms = 0;   // Programmzeit seit dem letzten Frame des Vorgängers
+
+  for (uint8_t s = 0; s < program.count; s++) {
+    const SequenceSegment &seg = program.segments[s];
+    if (seg.type == SEG_DELAY) {
+      gap_ms += (uint64_t)seg.period_ms * max(seg.repeat, (uint16_t)1);
+      continue;
+    }
+    bool endless = seg.count == 0 && seg.type == SEG_INTERVAL;
+    if (seg.count == 0 && !endless) continue;   // Leeres Segment
+
+    uint32_t frames = sequence_segment_frames(seg);
+    uint32_t step = 0xFFFFFFFF;
+    uint32_t lead = 0;   // Abstand Segmentbeginn -> erster Frame
+    switch (seg.type) {
+      case SEG_BURST:    step = seg.period_ms; lead = 0; break;
+      case SEG_INTERVAL: step = seg.period_ms; lead = seg.period_ms; break;
+      case SEG_SPREAD:   step = seg.period_ms / seg.count; lead = step; break;
+      case SEG_RAMP:     step = min(seg.period_ms, seg.end_ms); lead = seg.period_ms; break;
+    }
+    if (endless || frames >= 2) spacing = min(spacing, step);
+
+    // Letzter Frame davor -> erster Frame dieses Segments
+    if (have_frame) spacing = (uint32_t)min((uint64_t)spacing, gap_ms + lead);
+    if (endless) break;   // Folgesegmente werden nie erreicht
+
+    have_frame = true;
+    gap_ms = seg.type == SEG_BURST ? seg.period_ms : 0;   // Burst wartet nach jedem Frame
+  }
+  return spacing;
+}
+
+// -----------------------------------------------------------------------------
+// Presets - die drei Betriebsmodi als Programme
+// -----------------------------------------------------------------------------
+void sequence_preset_timer(SequenceProgram &program, uint32_t delay_ms, uint32_t hold_ms, uint32_t focus_ms) {
+  // Delay, dann ein Frame (Trigger oder Bulb). Die Pause danach hält den Lauf bis zum Bulb-Ende.
+  sequence_clear(program);
+  sequence_add(program, SEG_DELAY, 0, delay_ms);
+  sequence_add(program, SEG_BURST, 1, hold_ms);
+  program.segments[1].hold_ms = hold_ms;
+  program.segments[1].focus_ms = focus_ms;
+}
+
+void sequence_preset_tlapse(SequenceProgram &program, uint32_t total_ms, uint32_t frames) {
+  // Frame k bei floor(k * total / frames), k = 1..frames
+  sequence_clear(program);
+  if (frames > 0) sequence_add(program, SEG_SPREAD, frames, total_ms);
+}
+
+void sequence_preset_interval(SequenceProgram &program, uint32_t interval_ms) {
+  // Frame k bei k * interval - endlos
+  sequence_clear(program);
+  sequence_add(program, SEG_INTERVAL, 0, interval_ms);
+}
+
+void sequence_preset_burst(SequenceProgram &program, uint32_t count, uint32_t period_ms, uint32_t pulse_ms) {
+  // Erster Impuls sofort, dann alle period_ms - nur Elektro-Release
+  sequence_clear(program);
+  if (count == 0) return;
+  sequence_add(program, SEG_BURST, count, period_ms);
+  program.segments[0].pulse_ms = pulse_ms;
+}
+
+void sequence_set_focus(SequenceProgram &program, uint32_t focus_ms) {
+  for (uint8_t s = 0; s < program.count; s++) {
+    // Burst-Impulse sind reine Release-Pulse - dort kein Fokus
+    if (program.segments[s].pulse_ms == 0) program.segments[s].focus_ms = focus_ms;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Keyframe-Rampen - Kurven in Q16-Festkomma
+// -----------------------------------------------------------------------------
+uint32_t ramp_curve_q16(uint8_t curve, uint32_t u) {
+  uint64_t x = u;
+  switch (curve) {
+    case RAMP_EASE_IN:
+      return (uint32_t)((x * x) >> 16);
+    case RAMP_EASE_OUT: {
+      uint64_t v = 65536 - x;
+      return 65536 - (uint32_t)((v * v) >> 16);
+    }
+    case RAMP_EASE_IN_OUT:
+      return (uint32_t)((x * x * (3 * 65536 - 2 * x)) >> 32);
+    default:
+      return u;
+  }
+}
+
+uint32_t ramp_step_ms(uint32_t start_ms, uint32_t end_ms, uint32_t frames, uint8_t curve, uint32_t k) {
+  // Abstand vor Frame k (1-basiert) eines Ramp-Segments - gleiche Rechnung wie im Interpreter
+  int64_t span = (int64_t)end_ms - (int64_t)start_ms;
+  int64_t step = 0;
+  if (frames > 1 && curve == RAMP_LINEAR) {
+    step = span * (int64_t)(k - 1) / (int64_t)(frames - 1);
+  } else if (frames > 1) {
+    uint32_t u = (uint32_t)(((uint64_t)(k - 1) << 16) / (frames - 1));
+    step = span * (int64_t)ramp_curve_q16(curve, u) / 65536;
+  }
+  return (uint32_t)((int64_t)start_ms + step);
+}
+
+uint64_t ramp_duration_ms(uint32_t start_ms, uint32_t end_ms, uint32_t frames, uint8_t curve) {
+  // Summe aller Abstände eines Ramp-Segments = Programmzeit seines letzten Frames
+  uint64_t total_ms = 0;
+  for (uint32_t k = 1; k <= frames; k++) {
+    total_ms += ramp_step_ms(start_ms, end_ms, frames, curve, k);
+  }
+  return total_ms;
+}
+
+uint32_t ramp_curve_mean_q16(uint8_t curve) {
+  // Integral der Kurve über 0..1 - bestimmt die Frame-Zahl eines Abschnitts
+  switch (curve) {
+    case RAMP_EASE_IN:  return 21845;   // 1/3
+    case RAMP_EASE_OUT: return 43691;   // 2/3
+    default:            return 32768;   // 1/2 (linear, smoothstep)
+  }
+}
+
+bool ramp_plan_valid(const RampPlan &plan) {
+  if (plan.count < 2 || plan.count > RAMP_MAX_KEYFRAMES || plan.curve > RAMP_EASE_IN_OUT) return false;
+  if (plan.keys[0].at_s != 0) return false;
+  for (uint8_t i = 0; i < plan.count; i++) {
+    if (plan.keys[i].interval_ms == 0) return false;
+    if (i > 0 && plan.keys[i].at_s <= plan.keys[i - 1].at_s) return false;
+  }
+  return true;
+}
+
+bool sequence_preset_ramp(SequenceProgram &program, const RampPlan &plan) {
+  // Ein Ramp-Segment je Keyframe-Paar. Die Frames eines Abschnitts reichen vom
+  // tatsächlichen Ende des vorigen bis zur absoluten Keyframe-Zeit - Rundung
+  // sammelt sich so nicht an, jeder Keyframe liegt höchstens einen Frame daneben.
+  sequence_clear(program);
+  if (!ramp_plan_valid(plan)) return false;
+
+  uint64_t planned_ms = 0;   // Programmzeit des letzten geplanten Frames
+  for (uint8_t i = 1; i < plan.count; i++) {
+    uint32_t start_ms = plan.keys[i - 1].interval_ms;
+    uint32_t end_ms = plan.keys[i].interval_ms;
+    uint64_t target_ms = (uint64_t)plan.keys[i].at_s * 1000;
+    uint64_t remaining_ms = target_ms > planned_ms ? target_ms - planned_ms : 0;
+    int64_t mean_ms = (int64_t)start_ms + 
+                      ((int64_t)end_ms - (int64_t)start_ms) * (int64_t)ramp_curve_mean_q16(plan.curve) / 65536;
+    uint32_t estimate = (uint32_t)max((uint64_t)1, (remaining_ms + (uint64_t)mean_ms / 2) / (uint64_t)mean_ms);
+
+    // Schätzung ±1 mit der exakten Dauer aus dem Interpreter prüfen, nächstliegende nehmen
+    uint32_t frames = estimate;
+    uint64_t duration_ms = 0;
+    uint64_t best_error = UINT64_MAX;
+    for (uint32_t candidate = max(estimate, (uint32_t)2) - 1; candidate <= estimate + 1; candidate++) {
+      uint64_t candidate_ms = ramp_duration_ms(start_ms, end_ms, candidate, plan.curve);
+      uint64_t error = candidate_ms > remaining_ms ? candidate_ms - remaining_ms : remaining_ms - candidate_ms;
+      if (error < best_error) {
+        best_error = error;
+        frames = candidate;
+        duration_ms = candidate_ms;
+      }
+    }
+
+    if (!sequence_add(program, SEG_RAMP, frames, start_ms, end_ms)) return false;
+    program.segments[program.count - 1].curve = plan.curve;
+    planned_ms += duration_ms;
+  }
+  return true;
+}
+
+int ramp_curve_from_char(char c) {
+  switch (toupper(c)) {
+    case 'L': return RAMP_LINEAR;
+    case 'I': return RAMP_EASE_IN;
+    case 'O': return RAMP_EASE_OUT;
+    case 'S': return RAMP_EASE_IN_OUT;
+    default:  return -1;
+  }
+}
+
+const char* ramp_curve_name(uint8_t curve) {
+  switch (curve) {
+    case RAMP_EASE_IN:     return "ease-in";
+    case RAMP_EASE_OUT:    return "ease-out";
+    case RAMP_EASE_IN_OUT: return "ease-in-out";
+    default:               return "linear";
+  }
+}
+
+bool ramp_parse(String text, RampPlan &plan) {
+  // Kurve bleibt wie vom Aufrufer gesetzt
+  plan.count = 0;
+  text.trim();
+
+  int start = 0;
+  while (start < (int)text.length()) {
+    int comma = text.indexOf(',', start);
+    if (comma == -1) comma = text.length();
+    String token = text.substring(start, comma);
+    token.trim();
+    start = comma + 1;
+
+    int at = token.indexOf('@');
+    if (at < 1 || plan.count >= RAMP_MAX_KEYFRAMES) return false;
+    long at_s = token.substring(0, at).toInt();
+    long interval_ms = token.substring(at + 1).toInt();
+    if (at_s < 0 || at_s > VALUE_MAX_DURATION_S || interval_ms <= 0) return false;
+
+    plan.keys[plan.count].at_s = at_s;
+    plan.keys[plan.count].interval_ms = interval_ms;
+    plan.count++;
+  }
+  return ramp_plan_valid(plan);
+}
+
+String ramp_plan_string(const RampPlan &plan) {
+  String result;
+  for (uint8_t i = 0; i < plan.count; i++) {
+    if (i > 0) result += ",";
+    result += String(plan.keys[i].at_s) + "@" + String(plan.keys[i].interval_ms);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// Textformat
+// -----------------------------------------------------------------------------
+bool sequence_parse(String text, SequenceProgram &program) {
+  sequence_clear(program);
+  text.trim();
+  if (text.length() == 0) return false;
+
+  int start = 0;
+  while (start < (int)text.length()) {
+    int comma = text.indexOf(',', start);
+    if (comma == -1) comma = text.length();
+    String token = text.substring(start, comma);
+    token.trim();
+    start = comma + 1;
+    if (token.length() < 2) return false;
+
+    // Optionale Wiederholung
+    uint16_t repeat = 1;
+    int star = token.indexOf('*');
+    if (star != -1) {
+      long r = token.substring(star + 1).toInt();
+      if (r < 1 || r > 65535) return false;
+      repeat = (uint16_t)r;
+      token = token.substring(0, star);
+    }
+
+    char type = toupper(token.charAt(0));
+    String args = token.substring(1);
+    int at = args.indexOf('@');
+    int slash = args.indexOf('/');
+    bool ok = false;
+    uint32_t count, period_ms, end_ms;
+
+    switch (type) {
+      case 'D':
+        if (!sequence_parse_value(args, SEQUENCE_MAX_MS, period_ms)) return false;
+        ok = sequence_add(program, SEG_DELAY, 0, period_ms, 0, repeat);
+        break;
+      case 'B':
+        if (at == -1 || !sequence_parse_value(args.substring(0, at), SEQUENCE_MAX_FRAMES, count) ||
+            !sequence_parse_value(args.substring(at + 1), SEQUENCE_MAX_MS, period_ms)) return false;
+        ok = sequence_add(program, SEG_BURST, count, period_ms, 0, repeat);
+        break;
+      case 'I':
+        if (at == -1 || !sequence_parse_value(args.substring(0, at), SEQUENCE_MAX_FRAMES, count) ||
+            !sequence_parse_value(args.substring(at + 1), SEQUENCE_MAX_MS, period_ms)) return false;
+        ok = sequence_add(program, SEG_INTERVAL, count, period_ms, 0, repeat);
+        break;
+      case 'S':
+        if (slash == -1 || !sequence_parse_value(args.substring(0, slash), SEQUENCE_MAX_FRAMES, count) ||
+            !sequence_parse_value(args.substring(slash + 1), SEQUENCE_MAX_MS, period_ms)) return false;
+        ok = sequence_add(program, SEG_SPREAD, count, period_ms, 0, repeat);
+        break;
+      case 'R': {
+        int dash = args.indexOf('-', at + 1);
+        if (at == -1 || dash == -1) return false;
+        int curve = RAMP_LINEAR;
+        int tilde = args.indexOf('~', dash + 1);
+        if (tilde != -1) {
+          curve = ramp_curve_from_char(args.charAt(tilde + 1));
+          if (curve < 0) return false;
+          args = args.substring(0, tilde);
+        }
+        if (!sequence_parse_value(args.substring(0, at), SEQUENCE_MAX_FRAMES, count) ||
+            !sequence_parse_value(args.substring(at + 1, dash), SEQUENCE_MAX_MS, period_ms) ||
+            !sequence_parse_value(args.substring(dash + 1), SEQUENCE_MAX_MS, end_ms)) return false;
+        ok = sequence_add(program, SEG_RAMP, count, period_ms, end_ms, repeat);
+        if (ok) program.segments[program.count - 1].curve = curve;
+        break;
+      }
+      default:
+        return false;
+    }
+    if (!ok) return false;
+  }
+  return program.count > 0;
+}
+
+bool sequence_parse_value(String text, uint32_t max_value, uint32_t &value) {
+  // Strenger als toInt(): kein Vorzeichen (-1 wäre als uint32 riesig), kein Überlauf
+  text.trim();
+  if (text.length() == 0 || text.length() > 10) return false;
+  uint64_t parsed = 0;
+  for (unsigned int i = 0; i < text.length(); i++) {
+    char c = text.charAt(i);
+    if (c < '0' || c > '9') return false;
+    parsed = parsed * 10 + (c - '0');
+  }
+  if (parsed > max_value) return false;
+  value = (uint32_t)parsed;
+  return true;
+}
+
+void sequence_print(const SequenceCode &code) {
+  Serial.printf("=== Sequence: %d ops ===\n", code.count);
+  for (uint8_t i = 0; i < code.count; i++) {
+    const SequenceOp &op = code.ops[i];
+    switch (op.code) {
+      case SEQ_OP_WAIT:        Serial.printf("%2d WAIT   %lu ms\n", i, (unsigned long)op.a); break;
+      case SEQ_OP_WAIT_SPREAD: Serial.printf("%2d SPREAD %lu ms / %lu (loop %d)\n", i, (unsigned long)op.a, (unsigned long)op.b, op.loop); break;
+      case SEQ_OP_WAIT_RAMP:   Serial.printf("%2d RAMP   %lu -> %lu ms, %lu steps, %s (loop %d)\n", i, (unsigned long)op.a, (unsigned long)op.b, (unsigned long)op.c, ramp_curve_name(op.curve), op.loop); break;
+      case SEQ_OP_FRAME:       Serial.printf("%2d FRAME  hold %lu ms, focus %lu ms, pulse %lu ms\n", i, (unsigned long)op.a, (unsigned long)op.b, (unsigned long)op.c); break;
+      case SEQ_OP_LOOP:        Serial.printf("%2d LOOP   -> %lu x%lu\n", i, (unsigned long)op.a, (unsigned long)op.b); break;
+      default:                 Serial.printf("%2d END\n", i); break;
+    }
+  }
+  Serial.println("========================");
+}
+
+#endif // SEQUENCE_H
@@ -10,6 +10,12 @@ settings.h - Persistent Settings Management System
 #include <Preferences.h>
 #include "config.h"
 #include "state_machine.h"
+#include "sequence.h"
+
+#if defined(ESP32)
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
 
 // =============================================================================
 // SETTINGS CONFIGURATION
@@ -22,14 +28,30 @@ settings.h - Persistent Settings Management System
 #define KEY_LED_ENABLED       "led_enabled"
 #define KEY_BT_ENABLED        "bt_enabled"
 #define KEY_TIMER_DELAY       "timer_delay"
-#define KEY_TIMER_RELEASE     "timer_release"
+#define KEY_TIMER_RELEASE     "timer_release"   // Alt: Sekunden - wird nach KEY_TIMER_RELEASE_MS migriert
+#define KEY_TIMER_RELEASE_MS  "timer_rel_ms"
 #define KEY_TLAPSE_TOTAL      "tlapse_total"
 #define KEY_TLAPSE_FRAMES     "tlapse_frames"
+#define KEY_TLAPSE_RAMP       "tlapse_ramp"     // Ramp-Endabstand in s (0 = aus)
 #define KEY_INTERVAL_TIME     "interval_time"
 #define KEY_SERVO_START_POS   "servo_start_pos"
 #define KEY_SERVO_END_POS     "servo_end_pos"
 #define KEY_SERVO_MAX_POS     "servo_max_pos"
 #define KEY_SERVO_ACT_TIME    "servo_act_time"
+#define KEY_CATCHUP_POLICY    "catchup_policy"
+#define KEY_BURST_COUNT       "burst_count"
+#define KEY_BURST_RATE        "burst_rate"
+#define KEY_BURST_PULSE       "burst_pulse"
+#define KEY_FRAME_FOCUS       "frame_focus"
+#define KEY_FOCUS_LEAD        "focus_lead"
+#define KEY_FOCUS_DURATION    "focus_dur"
+#define KEY_LOW_POWER         "low_power"
+#define KEY_DEEP_SLEEP        "deep_sleep"
+#define KEY_RAMP_CURVE        "ramp_curve"
+#define KEY_RESUME_SHIFT      "resume_shift"
+#define KEY_EXT_DELAY         "ext_delay"
+#define KEY_EXT_LOCKOUT       "ext_lockout"
+#define KEY_EXT_SERVO         "ext_servo"
 #define KEY_SETTINGS_VERSION  "version"
 
 // =============================================================================
@@ -46,6 +68,27 @@ void save_app_state();
 void save_timer_values();
 void save_servo_settings();
 
+// Mit laufenden Tasks schreibt der Housekeeping-Task (tasks.h) - NVS-Writes können
+// beim Flash-Erase einige 10 ms blockieren. Die _now-Varianten schreiben sofort.
+enum PersistRequest {
+  PERSIST_SETTINGS,
+  PERSIST_APP_STATE,
+  PERSIST_TIMER_VALUES
+};
+extern bool housekeeping_persist(uint8_t request);   // false = Task läuft nicht
+void save_settings_now();
+void save_app_state_now();
+void save_timer_values_now();
+
+// Preferences ist nicht threadsicher: UI-Task (load/reset/info/exist) und
+// Housekeeping-Task (save_*_now) halten den Lock um jeden begin()...end()-Block
+void settings_lock();
+void settings_unlock();
+
+// Timer-Release in ms (Preferences müssen geöffnet sein)
+uint32_t load_timer_release_ms();
+void save_timer_release_ms();
+
 // Settings info and debug
 void print_settings_info();
 void handle_settings_serial_commands(String command);
@@ -62,9 +105,30 @@ extern bool settings_initialized;
 Preferences preferences;
 bool settings_initialized = false;
 
+#if defined(ESP32)
+SemaphoreHandle_t settings_mutex = nullptr;
+#endif
+
+void settings_lock() {
+#if defined(ESP32)
+  if (settings_mutex) xSemaphoreTakeRecursive(settings_mutex, portMAX_DELAY);
+#endif
+}
+
+void settings_unlock() {
+#if defined(ESP32)
+  if (settings_mutex) xSemaphoreGiveRecursive(settings_mutex);
+#endif
+}
+
 void settings_init() {
   DEBUG_PRINTLN("Initializing settings system...");
   
+#if defined(ESP32)
+  // Vor tasks_start() - danach greifen UI- und Housekeeping-Task parallel zu
+  if (!settings_mutex) settings_mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+  
   if (settings_exist()) {
     load_settings();
     DEBUG_PRINTLN("Settings loaded from flash");
@@ -79,14 +143,18 @@ void settings_init() {
 }
 
 bool settings_exist() {
+  settings_lock();
   preferences.begin(SETTINGS_NAMESPACE, true); // read-only
   bool exists = preferences.isKey(KEY_SETTINGS_VERSION);
   preferences.end();
+  settings_unlock();
   return exists;
 }
 
 void load_settings() {
+  settings_lock();
   if (!preferences.begin(SETTINGS_NAMESPACE, true)) {
+    settings_unlock();
     DEBUG_PRINTLN("ERROR: Failed to open preferences for reading");
     return;
   }
@@ -96,6 +164,7 @@ void load_settings() {
   if (saved_version != SETTINGS_VERSION) {
     DEBUG_PRINTF("Settings version mismatch: saved=%d, current=%d\n", saved_version, SETTINGS_VERSION);
     preferences.end();
+    settings_unlock();
     reset_settings_to_defaults();
     return;
   }
@@ -104,18 +173,33 @@ void load_settings() {
   app_state.servo_wire_percentage = preferences.getInt(KEY_SERVO_WIRE_PCT, 100);
   app_state.led_enabled = preferences.getBool(KEY_LED_ENABLED, true);
   app_state.bluetooth_enabled = preferences.getBool(KEY_BT_ENABLED, false);
+  app_state.catchup_policy = preferences.getInt(KEY_CATCHUP_POLICY, CATCHUP_SKIP);
+  app_state.burst_count = preferences.getInt(KEY_BURST_COUNT, BURST_DEFAULT_COUNT);
+  app_state.burst_rate_hz = preferences.getInt(KEY_BURST_RATE, BURST_DEFAULT_RATE_HZ);
+  app_state.burst_pulse_ms = preferences.getInt(KEY_BURST_PULSE, BURST_DEFAULT_PULSE_MS);
+  app_state.frame_focus = preferences.getBool(KEY_FRAME_FOCUS, true);
+  app_state.focus_lead_ms = preferences.getInt(KEY_FOCUS_LEAD, FOCUS_DEFAULT_LEAD_MS);
+  app_state.focus_duration_ms = preferences.getInt(KEY_FOCUS_DURATION, FOCUS_DEFAULT_DURATION_MS);
+  app_state.low_power = preferences.getBool(KEY_LOW_POWER, true);
+  app_state.deep_sleep = preferences.getBool(KEY_DEEP_SLEEP, false);
+  app_state.ramp_curve = constrain(preferences.getInt(KEY_RAMP_CURVE, RAMP_LINEAR), RAMP_LINEAR, RAMP_EASE_IN_OUT);
+  app_state.resume_shift = preferences.getBool(KEY_RESUME_SHIFT, false);
+  app_state.ext_delay_ms = constrain(preferences.getInt(KEY_EXT_DELAY, 0), 0, EXT_TRIGGER_MAX_DELAY_MS);
+  app_state.ext_lockout_ms = constrain(preferences.getInt(KEY_EXT_LOCKOUT, EXT_TRIGGER_DEFAULT_LOCKOUT_MS), 
+                                       0, EXT_TRIGGER_MAX_LOCKOUT_MS);
+  app_state.ext_servo = preferences.getBool(KEY_EXT_SERVO, false);
   
   // Load timer values AND initialize labels
   timer_values.page_title = "Timer";
   timer_values.option1_label = "Delay";
   timer_values.option2_label = "Release";
   timer_values.option1 = {
-    preferences.getUInt(KEY_TIMER_DELAY, 0),
-    VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL
+    min((uint32_t)preferences.getUInt(KEY_TIMER_DELAY, 0), (uint32_t)VALUE_MAX_DURATION_S),
+    VALUE_FORMAT_DURATION, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL
   };
   timer_values.option2 = {
-    preferences.getUInt(KEY_TIMER_RELEASE, 0),
-    VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL
+    load_timer_release_ms(),
+    VALUE_FORMAT_MM_SS_T, 0, VALUE_MAX_MS, VALUE_INCREMENT_TENTH
   };
   
   // Load T-Lapse values AND initialize labels
@@ -123,21 +207,26 @@ void load_settings() {
   tlapse_values.option1_label = "Total";
   tlapse_values.option2_label = "Frames";
   tlapse_values.option1 = {
-    preferences.getUInt(KEY_TLAPSE_TOTAL, 0),
-    VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL
+    min((uint32_t)preferences.getUInt(KEY_TLAPSE_TOTAL, 0), (uint32_t)VALUE_MAX_DURATION_S),
+    VALUE_FORMAT_DURATION, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL
   };
   tlapse_values.option2 = {
     preferences.getUInt(KEY_TLAPSE_FRAMES, 0),
     VALUE_FORMAT_COUNT, 0, 0, 1
   };
+  tlapse_values.option3_label = "Ramp";
+  tlapse_values.option3 = {
+    min((uint32_t)preferences.getUInt(KEY_TLAPSE_RAMP, 0), (uint32_t)VALUE_MAX_SECONDS),
+    VALUE_FORMAT_RAMP, 0, VALUE_MAX_SECONDS, VALUE_INCREMENT_SMALL
+  };
   
   // Load Interval values AND initialize labels
   interval_values.page_title = "Interval";
   interval_values.option1_label = "Interval";
   interval_values.option2_label = "";  // Empty, not used
   interval_values.option1 = {
-    preferences.getUInt(KEY_INTERVAL_TIME, 0),
-    VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL
+    min((uint32_t)preferences.getUInt(KEY_INTERVAL_TIME, 0), (uint32_t)VALUE_MAX_DURATION_S),
+    VALUE_FORMAT_INTERVAL, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL
   };
   interval_values.option2 = {0, VALUE_FORMAT_COUNT, 0, 0, 1}; // Not used
   
@@ -145,9 +234,10 @@ void load_settings() {
   // servoStartPosition = preferences.getInt(KEY_SERVO_START_POS, SERVO_START_POSITION);
   // servoEndPosition = preferences.getInt(KEY_SERVO_END_POS, SERVO_END_POSITION);
   // servoAbsoluteMaxPosition = preferences.getInt(KEY_SERVO_MAX_POS, SERVO_ABSOLUTE_MAX_POSITION);
-  // servoActivationTime = preferences.getFloat(KEY_SERVO_ACT_TIME, SERVO_ACTIVATION_TIME);
+  // Servo-Haltezeit: Breite von Ausgabekanal 0 (outputs_init() -> servo_activation_us)
   
   preferences.end();
+  settings_unlock();
   
   // Update page content after loading
   update_page_content_from_values(STATE_TIMER);
@@ -158,7 +248,13 @@ void load_settings() {
 }
 
 void save_settings() {
+  if (!housekeeping_persist(PERSIST_SETTINGS)) save_settings_now();
+}
+
+void save_settings_now() {
+  settings_lock();
   if (!settings_initialized && !preferences.begin(SETTINGS_NAMESPACE, false)) {
+    settings_unlock();
     DEBUG_PRINTLN("ERROR: Failed to open preferences for writing");
     return;
   }
@@ -174,40 +270,102 @@ void save_settings() {
   preferences.putInt(KEY_SERVO_WIRE_PCT, app_state.servo_wire_percentage);
   preferences.putBool(KEY_LED_ENABLED, app_state.led_enabled);
   preferences.putBool(KEY_BT_ENABLED, app_state.bluetooth_enabled);
+  preferences.putInt(KEY_CATCHUP_POLICY, app_state.catchup_policy);
+  preferences.putInt(KEY_BURST_COUNT, app_state.burst_count);
+  preferences.putInt(KEY_BURST_RATE, app_state.burst_rate_hz);
+  preferences.putInt(KEY_BURST_PULSE, app_state.burst_pulse_ms);
+  preferences.putBool(KEY_FRAME_FOCUS, app_state.frame_focus);
+  preferences.putInt(KEY_FOCUS_LEAD, app_state.focus_lead_ms);
+  preferences.putInt(KEY_FOCUS_DURATION, app_state.focus_duration_ms);
+  preferences.putBool(KEY_LOW_POWER, app_state.low_power);
+  preferences.putBool(KEY_DEEP_SLEEP, app_state.deep_sleep);
+  preferences.putInt(KEY_RAMP_CURVE, app_state.ramp_curve);
+  preferences.putBool(KEY_RESUME_SHIFT, app_state.resume_shift);
+  preferences.putInt(KEY_EXT_DELAY, app_state.ext_delay_ms);
+  preferences.putInt(KEY_EXT_LOCKOUT, app_state.ext_lockout_ms);
+  preferences.putBool(KEY_EXT_SERVO, app_state.ext_servo);
   
   // Save timer values
-  preferences.putUInt(KEY_TIMER_DELAY, timer_values.option1.seconds);
-  preferences.putUInt(KEY_TIMER_RELEASE, timer_values.option2.seconds);
-  preferences.putUInt(KEY_TLAPSE_TOTAL, tlapse_values.option1.seconds);
-  preferences.putUInt(KEY_TLAPSE_FRAMES, tlapse_values.option2.seconds);
-  preferences.putUInt(KEY_INTERVAL_TIME, interval_values.option1.seconds);
+  preferences.putUInt(KEY_TIMER_DELAY, timer_values.option1.value);
+  save_timer_release_ms();
+  preferences.putUInt(KEY_TLAPSE_TOTAL, tlapse_values.option1.value);
+  preferences.putUInt(KEY_TLAPSE_FRAMES, tlapse_values.option2.value);
+  preferences.putUInt(KEY_TLAPSE_RAMP, tlapse_values.option3.value);
+  preferences.putUInt(KEY_INTERVAL_TIME, interval_values.option1.value);
   
   // Save servo settings (if implemented)
   // preferences.putInt(KEY_SERVO_START_POS, servoStartPosition);
   // preferences.putInt(KEY_SERVO_END_POS, servoEndPosition);
   // preferences.putInt(KEY_SERVO_MAX_POS, servoAbsoluteMaxPosition);
-  // preferences.putFloat(KEY_SERVO_ACT_TIME, servoActivationTime);
   
   preferences.end();
+  settings_unlock();
   DEBUG_PRINTLN("Settings saved to flash");
 }
 
 void save_app_state() {
+  if (!housekeeping_persist(PERSIST_APP_STATE)) save_app_state_now();
+}
+
+void save_app_state_now() {
+  settings_lock();
   preferences.begin(SETTINGS_NAMESPACE, false);
   preferences.putInt(KEY_SERVO_WIRE_PCT, app_state.servo_wire_percentage);
   preferences.putBool(KEY_LED_ENABLED, app_state.led_enabled);
   preferences.putBool(KEY_BT_ENABLED, app_state.bluetooth_enabled);
+  preferences.putInt(KEY_CATCHUP_POLICY, app_state.catchup_policy);
+  preferences.putInt(KEY_BURST_COUNT, app_state.burst_count);
+  preferences.putInt(KEY_BURST_RATE, app_state.burst_rate_hz);
+  preferences.putInt(KEY_BURST_PULSE, app_state.burst_pulse_ms);
+  preferences.putBool(KEY_FRAME_FOCUS, app_state.frame_focus);
+  preferences.putInt(KEY_FOCUS_LEAD, app_state.focus_lead_ms);
+  preferences.putInt(KEY_FOCUS_DURATION, app_state.focus_duration_ms);
+  preferences.putBool(KEY_LOW_POWER, app_state.low_power);
+  preferences.putBool(KEY_DEEP_SLEEP, app_state.deep_sleep);
+  preferences.putInt(KEY_RAMP_CURVE, app_state.ramp_curve);
+  preferences.putBool(KEY_RESUME_SHIFT, app_state.resume_shift);
+  preferences.putInt(KEY_EXT_DELAY, app_state.ext_delay_ms);
+  preferences.putInt(KEY_EXT_LOCKOUT, app_state.ext_lockout_ms);
+  preferences.putBool(KEY_EXT_SERVO, app_state.ext_servo);
   preferences.end();
+  settings_unlock();
 }
 
 void save_timer_values() {
+  if (!housekeeping_persist(PERSIST_TIMER_VALUES)) save_timer_values_now();
+}
+
+void save_timer_values_now() {
+  settings_lock();
   preferences.begin(SETTINGS_NAMESPACE, false);
-  preferences.putUInt(KEY_TIMER_DELAY, timer_values.option1.seconds);
-  preferences.putUInt(KEY_TIMER_RELEASE, timer_values.option2.seconds);
-  preferences.putUInt(KEY_TLAPSE_TOTAL, tlapse_values.option1.seconds);
-  preferences.putUInt(KEY_TLAPSE_FRAMES, tlapse_values.option2.seconds);
-  preferences.putUInt(KEY_INTERVAL_TIME, interval_values.option1.seconds);
+  preferences.putUInt(KEY_TIMER_DELAY, timer_values.option1.value);
+  save_timer_release_ms();
+  preferences.putUInt(KEY_TLAPSE_TOTAL, tlapse_values.option1.value);
+  preferences.putUInt(KEY_TLAPSE_FRAMES, tlapse_values.option2.value);
+  preferences.putUInt(KEY_TLAPSE_RAMP, tlapse_values.option3.value);
+  preferences.putUInt(KEY_INTERVAL_TIME, interval_values.option1.value);
   preferences.end();
+  settings_unlock();
+}
+
+uint32_t load_timer_release_ms() {
+  if (preferences.isKey(KEY_TIMER_RELEASE_MS)) {
+    return preferences.getUInt(KEY_TIMER_RELEASE_MS, 0);
+  }
+  
+  // Migration: alter Sekundenwert (-1 = SHOT bleibt -1)
+  uint32_t old_seconds = preferences.getUInt(KEY_TIMER_RELEASE, 0);
+  if ((int32_t)old_seconds == -1) return old_seconds;
+  if (old_seconds > VALUE_MAX_MS / 1000) old_seconds = VALUE_MAX_MS / 1000;
+  DEBUG_PRINTF("Migrating timer release %lus -> %lums\n", (unsigned long)old_seconds, (unsigned long)old_seconds * 1000);
+  return old_seconds * 1000;
+}
+
+void save_timer_release_ms() {
+  preferences.putUInt(KEY_TIMER_RELEASE_MS, timer_values.option2.value);
+  if (preferences.isKey(KEY_TIMER_RELEASE)) {
+    preferences.remove(KEY_TIMER_RELEASE);
+  }
 }
 
 void save_servo_settings() {
@@ -215,7 +373,6 @@ void save_servo_settings() {
   // preferences.putInt(KEY_SERVO_START_POS, servoStartPosition);
   // preferences.putInt(KEY_SERVO_END_POS, servoEndPosition);
   // preferences.putInt(KEY_SERVO_MAX_POS, servoAbsoluteMaxPosition);
-  // preferences.putFloat(KEY_SERVO_ACT_TIME, servoActivationTime);
   // preferences.end();
   // Uncomment when servo settings are implemented
 }
@@ -223,14 +380,30 @@ void save_servo_settings() {
 void reset_settings_to_defaults() {
   DEBUG_PRINTLN("Resetting settings to defaults...");
   
+  settings_lock();
   preferences.begin(SETTINGS_NAMESPACE, false);
   preferences.clear(); // Clear all keys
   preferences.end();
+  settings_unlock();
   
   // Reset to default values
   app_state.servo_wire_percentage = 100;
   app_state.led_enabled = true;
   app_state.bluetooth_enabled = false;
+  app_state.catchup_policy = CATCHUP_SKIP;
+  app_state.burst_count = BURST_DEFAULT_COUNT;
+  app_state.burst_rate_hz = BURST_DEFAULT_RATE_HZ;
+  app_state.burst_pulse_ms = BURST_DEFAULT_PULSE_MS;
+  app_state.frame_focus = true;
+  app_state.focus_lead_ms = FOCUS_DEFAULT_LEAD_MS;
+  app_state.focus_duration_ms = FOCUS_DEFAULT_DURATION_MS;
+  app_state.low_power = true;
+  app_state.deep_sleep = false;
+  app_state.ramp_curve = RAMP_LINEAR;
+  app_state.resume_shift = false;
+  app_state.ext_delay_ms = 0;
+  app_state.ext_lockout_ms = EXT_TRIGGER_DEFAULT_LOCKOUT_MS;
+  app_state.ext_servo = false;
   
   // Reset timer values through existing function
   values_init();
@@ -246,16 +419,33 @@ void print_settings_info() {
   DEBUG_PRINTF("Servo Wire: %d%%\n", app_state.servo_wire_percentage);
   DEBUG_PRINTF("LED: %s\n", app_state.led_enabled ? "ON" : "OFF");
   DEBUG_PRINTF("Bluetooth: %s\n", app_state.bluetooth_enabled ? "ON" : "OFF");
-  DEBUG_PRINTF("Timer Delay: %ds\n", timer_values.option1.seconds);
-  DEBUG_PRINTF("Timer Release: %ds\n", timer_values.option2.seconds);
-  DEBUG_PRINTF("T-Lapse Total: %ds\n", tlapse_values.option1.seconds);
-  DEBUG_PRINTF("T-Lapse Frames: %d\n", tlapse_values.option2.seconds);
-  DEBUG_PRINTF("Interval: %ds\n", interval_values.option1.seconds);
+  DEBUG_PRINTF("Catch-up: %d\n", app_state.catchup_policy);
+  DEBUG_PRINTF("Burst: %d x %d Hz, %d ms pulse\n", app_state.burst_count, app_state.burst_rate_hz, app_state.burst_pulse_ms);
+  DEBUG_PRINTF("Focus: lead %d ms, duration %d ms, every frame %s\n", 
+               app_state.focus_lead_ms, app_state.focus_duration_ms, app_state.frame_focus ? "ON" : "OFF");
+  DEBUG_PRINTF("Low-power runs: %s, deep sleep: %s\n", app_state.low_power ? "ON" : "OFF", 
+               app_state.deep_sleep ? "ON" : "OFF");
+  DEBUG_PRINTF("Resume after pause: %s\n", app_state.resume_shift ? "shift" : "grid");
+  DEBUG_PRINTF("External trigger: delay %d ms, lockout %d ms, servo %s\n", app_state.ext_delay_ms,
+               app_state.ext_lockout_ms, app_state.ext_servo ? "ON" : "OFF");
+  DEBUG_PRINTF("Timer Delay: %ds\n", timer_values.option1.value);
+  if ((int32_t)timer_values.option2.value == -1) {
+    DEBUG_PRINTLN("Timer Release: SHOT");
+  } else {
+    DEBUG_PRINTF("Timer Release: %lums\n", (unsigned long)timer_values.option2.value);
+  }
+  DEBUG_PRINTF("T-Lapse Total: %ds\n", tlapse_values.option1.value);
+  DEBUG_PRINTF("T-Lapse Frames: %d\n", tlapse_values.option2.value);
+  DEBUG_PRINTF("T-Lapse Ramp: %s (%s)\n", format_time_value(tlapse_values.option3.value, VALUE_FORMAT_RAMP).c_str(),
+               ramp_curve_name(app_state.ramp_curve));
+  DEBUG_PRINTF("Interval: %ds\n", interval_values.option1.value);
   
   // Storage info
+  settings_lock();
   preferences.begin(SETTINGS_NAMESPACE, true);
   size_t used_entries = preferences.freeEntries();
   preferences.end();
+  settings_unlock();
   
   DEBUG_PRINTF("Storage: %d entries used\n", used_entries);
   DEBUG_PRINTLN("========================");
@@ -26,16 +26,24 @@ enum AppState {
   STATE_TLAPSE, 
   STATE_INTERVAL,
   STATE_SETTINGS,
-  STATE_WIRE_SETTINGS
+  STATE_WIRE_SETTINGS,
+  STATE_BURST        // Burst-Editor (Settings -> Burst), Template mit drei Karten
 };
 
 // REMOVED: DetailContext enum - no longer needed
 
+// Verhalten bei verpassten T-Lapse/Interval-Frames (Loop/Dispatch zu spät)
+enum CatchUpPolicy {
+  CATCHUP_SKIP,       // Verpassten Frame auslassen, Raster bleibt
+  CATCHUP_FIRE_NOW,   // Verspäteten Frame sofort nachholen
+  CATCHUP_SHIFT       // Frame sofort auslösen und Restplan um die Verspätung verschieben
+};
+
 // =============================================================================
 // VALUE STORAGE STRUCTURES
 // =============================================================================
 struct OptionValue {
-  uint32_t seconds;         // Store time in seconds
+  uint32_t value;           // Sekunden, Anzahl - bei VALUE_FORMAT_MM_SS_T Millisekunden
   uint8_t format;           // Display format (MM:SS, SS, COUNT)
   uint32_t min_value;       // Minimum allowed value
   uint32_t max_value;       // Maximum allowed value
@@ -48,6 +56,8 @@ struct PageValues {
   String option1_label;
   String option2_label;
   String page_title;
+  OptionValue option3;      // Nur T-Lapse: Ramp-Endabstand (Label leer = keine dritte Karte)
+  String option3_label;
 };
 
 // =============================================================================
@@ -59,6 +69,8 @@ struct PageContent {
   String option2_text;
   String option1_time;
   String option2_time;
+  String option3_text;
+  String option3_time;
 };
 
 struct AppStateData {
@@ -73,6 +85,20 @@ struct AppStateData {
   bool led_enabled;
   bool bluetooth_enabled;
   int servo_wire_percentage;
+  int catchup_policy;           // CatchUpPolicy
+  int burst_count;              // Elektro-Burst: Impulse
+  int burst_rate_hz;            // Elektro-Burst: Impulse pro Sekunde
+  int burst_pulse_ms;           // Elektro-Burst: Release-Pulsbreite
+  bool frame_focus;             // Fokus/Wake-Impuls vor jedem T-Lapse/Interval-Frame
+  int focus_lead_ms;            // Fokus-Vorlauf vor dem Release
+  int focus_duration_ms;        // Dauer des Fokus-Signals
+  bool low_power;               // Light-Sleep zwischen den Frames langer Läufe
+  bool deep_sleep;              // Deep-Sleep bei großen Lücken, Lauf im RTC-Speicher
+  int ramp_curve;               // RampCurve der T-Lapse-Rampe
+  bool resume_shift;            // Nach Pause: true = Rest verschieben, false = altes Raster
+  int ext_delay_ms;             // Externer Trigger: Verzögerung Flanke -> Release
+  int ext_lockout_ms;           // Externer Trigger: Sperrzeit nach einer Auslösung
+  bool ext_servo;               // Externer Trigger: Servo zusätzlich zum Elektro-Release
 };
 
 // =============================================================================
@@ -82,11 +108,13 @@ extern AppStateData app_state;
 extern PageContent timer_content;
 extern PageContent tlapse_content;
 extern PageContent interval_content;
+extern PageContent burst_content;
 
 // Value storage for all pages
 extern PageValues timer_values;
 extern PageValues tlapse_values;
 extern PageValues interval_values;
+extern PageValues burst_values;     // Spiegel von app_state.burst_* - gespeichert wird app_state
 
 // =============================================================================
 // STATE MANAGEMENT FUNCTIONS
@@ -104,11 +132,15 @@ bool is_main_template_state(AppState state);
 // VALUE MANAGEMENT FUNCTIONS
 // =============================================================================
 void values_init();
-String format_time_value(uint32_t centiseconds, uint8_t format);
+String format_time_value(uint32_t value, uint8_t format);
+uint32_t option_step(const OptionValue &option, uint32_t value);   // Encoder-Schritt je nach Größe des Werts
 void update_option_value(AppState page, int option, int32_t delta);
 uint32_t get_option_value(AppState page, int option);
+int page_option_count(AppState page);     // Karten auf der Seite (Timer 2, T-Lapse 3, Interval 1, Burst 3)
+OptionValue* page_option(PageValues *values, int option);
 PageValues* get_current_page_values();
 void update_page_content_from_values(AppState page);
+void burst_values_from_state();           // Karten aus app_state.burst_* (nach Laden/BLE/Serial)
 
 // =============================================================================
 // DATA MANAGEMENT FUNCTIONS - SIMPLIFIED
@@ -133,23 +165,44 @@ AppStateData app_state = {
   false,   // encoder_editing_mode
   true,   // led toggle
   true,  // bluetooth toggle
-  100     
+  100,
+  CATCHUP_SKIP,
+  BURST_DEFAULT_COUNT,
+  BURST_DEFAULT_RATE_HZ,
+  BURST_DEFAULT_PULSE_MS,
+  true,   // frame_focus
+  FOCUS_DEFAULT_LEAD_MS,
+  FOCUS_DEFAULT_DURATION_MS,
+  true,   // low_power
+  false,  // deep_sleep
+  0,      // ramp_curve (RAMP_LINEAR)
+  false,  // resume_shift
+  0,      // ext_delay_ms
+  EXT_TRIGGER_DEFAULT_LOCKOUT_MS,
+  false   // ext_servo
 };
 
 // Value storage - unchanged
 PageValues timer_values;
 PageValues tlapse_values;
 PageValues interval_values;
+PageValues burst_values;
 
 // Content data - will be updated from values
 PageContent timer_content = {"Timer", "Delay", "Release", "00:00", "00:00"};
-PageContent tlapse_content = {"Timelapse", "Total", "Frames", "00:00", "0"};
+PageContent tlapse_content = {"Timelapse", "Total", "Frames", "00:00", "0", "Ramp", "OFF"};
 PageContent interval_content = {"Interval", "Interval", "", "00:00", ""}; // No second option
+PageContent burst_content = {"Burst", "Count", "Rate", "5", "10Hz", "Pulse", "30ms"};
 
 // Forward declaration for UI
 void show_current_page();
 void update_template_content(PageContent content);
 
+// Forward declaration for timer_system.h - max. Frames, die die Ausgänge schaffen
+uint32_t tlapse_max_frames(uint32_t total_seconds);
+uint32_t burst_max_pulse_ms(int rate_hz);
+void set_burst_config(int count, int rate_hz, int pulse_ms);
+
 // =============================================================================
 // VALUE MANAGEMENT IMPLEMENTATION
 // =============================================================================
@@ -169,8 +222,8 @@ void values_init() {
     timer_values.page_title = "Timer";
     timer_values.option1_label = "Delay";
     timer_values.option2_label = "Release";
-    timer_values.option1 = {0, VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL};
-    timer_values.option2 = {0, VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL};
+    timer_values.option1 = {0, VALUE_FORMAT_DURATION, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL};
+    timer_values.option2 = {0, VALUE_FORMAT_MM_SS_T, 0, VALUE_MAX_MS, VALUE_INCREMENT_TENTH};
   }
   
   if (need_tlapse_init) {
@@ -178,8 +231,10 @@ void values_init() {
     tlapse_values.page_title = "Timelapse";
     tlapse_values.option1_label = "Total";
     tlapse_values.option2_label = "Frames";
-    tlapse_values.option1 = {0, VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL};
+    tlapse_values.option1 = {0, VALUE_FORMAT_DURATION, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL};
     tlapse_values.option2 = {0, VALUE_FORMAT_COUNT, 0, 0, 1};
+    tlapse_values.option3_label = "Ramp";
+    tlapse_values.option3 = {0, VALUE_FORMAT_RAMP, 0, VALUE_MAX_SECONDS, VALUE_INCREMENT_SMALL};
   }
   
   if (need_interval_init) {
@@ -187,10 +242,17 @@ void values_init() {
     interval_values.page_title = "Interval";
     interval_values.option1_label = "Interval";
     interval_values.option2_label = "";  // Empty, not used
-    interval_values.option1 = {0, VALUE_FORMAT_MM_SS, 0, 3599, VALUE_INCREMENT_SMALL};
+    interval_values.option1 = {0, VALUE_FORMAT_INTERVAL, 0, VALUE_MAX_DURATION_S, VALUE_INCREMENT_SMALL};
     interval_values.option2 = {0, VALUE_FORMAT_COUNT, 0, 0, 1}; // Not used
   }
   
+  // Burst-Werte liegen in app_state - die Karten sind nur der Editor dafür
+  burst_values.page_title = "Burst";
+  burst_values.option1_label = "Count";
+  burst_values.option2_label = "Rate";
+  burst_values.option3_label = "Pulse";
+  burst_values_from_state();
+  
   // Always update page content from loaded/initialized values
   update_page_content_from_values(STATE_TIMER);
   update_page_content_from_values(STATE_TLAPSE);
@@ -199,25 +261,74 @@ void values_init() {
   DEBUG_PRINTLN("Value storage initialized - all pages ready");
 }
 
-String format_time_value(uint32_t seconds, uint8_t format) {
+String format_time_value(uint32_t value, uint8_t format) {
   // Handle trigger mode for timer release
-  if (seconds == 4294967295 || (int32_t)seconds == -1) {
+  if (value == 4294967295 || (int32_t)value == -1) {
     return "SHOT";
   }
   
   switch (format) {
     case VALUE_FORMAT_MM_SS: {
+      uint16_t minutes = value / 60;
+      uint16_t secs = value % 60;
+      return (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
+             (secs < 10 ? "0" : "") + String(secs);
+    }
+    case VALUE_FORMAT_MM_SS_T: {
+      // Millisekunden -> MM:SS.t (Zehntel abgeschnitten)
+      uint32_t seconds = value / 1000;
       uint16_t minutes = seconds / 60;
       uint16_t secs = seconds % 60;
+      uint16_t tenths = (value % 1000) / 100;
       return (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
-             (secs < 10 ? "0" : "") + String(secs);
+             (secs < 10 ? "0" : "") + String(secs) + "." + String(tenths);
+    }
+    case VALUE_FORMAT_DURATION: {
+      // Mehrtägige Läufe: Anzeige wird mit der Dauer gröber (passt zu option_step)
+      if (value < 3600) return format_time_value(value, VALUE_FORMAT_MM_SS);
+      uint32_t days = value / 86400;
+      uint16_t hours = (value % 86400) / 3600;
+      uint16_t minutes = (value % 3600) / 60;
+      if (days == 0) {
+        return String(hours) + "h" + (minutes < 10 ? "0" : "") + String(minutes) + "m";
+      }
+      return String(days) + "d" + (hours < 10 ? "0" : "") + String(hours) + "h";
     }
     case VALUE_FORMAT_SS: {
-      return (seconds < 10 ? "0" : "") + String(seconds);
+      return (value < 10 ? "0" : "") + String(value);
+    }
+    case VALUE_FORMAT_RAMP: {
+      return value == 0 ? "OFF" : format_time_value(value, VALUE_FORMAT_MM_SS);
+    }
+    case VALUE_FORMAT_INTERVAL: {
+      return value == 0 ? "EXT" : format_time_value(value, VALUE_FORMAT_DURATION);
+    }
+    case VALUE_FORMAT_HZ: {
+      return String(value) + "Hz";
+    }
+    case VALUE_FORMAT_PULSE_MS: {
+      return String(value) + "ms";
     }
     case VALUE_FORMAT_COUNT:
     default:
-      return String(seconds);
+      return String(value);
+  }
+}
+
+uint32_t option_step(const OptionValue &option, uint32_t value) {
+  switch (option.format) {
+    case VALUE_FORMAT_DURATION:
+    case VALUE_FORMAT_INTERVAL:
+      if (value < 3600) return option.increment;   // Sekunden
+      if (value < 86400) return 60;                // Minuten
+      return 3600;                                 // Stunden
+    case VALUE_FORMAT_COUNT:
+      // Frame-Zahlen bis 10 000+ - ab 1000 in Zehnern, ab 10 000 in Hundertern
+      if (value < 1000) return option.increment;
+      if (value < 10000) return 10;
+      return 100;
+    default:
+      return option.increment;
   }
 }
 
@@ -226,6 +337,7 @@ PageValues* get_current_page_values() {
     case STATE_TIMER: return &timer_values;
     case STATE_TLAPSE: return &tlapse_values;
     case STATE_INTERVAL: return &interval_values;
+    case STATE_BURST: return &burst_values;
     default: return &timer_values;
   }
 }
@@ -236,10 +348,29 @@ uint32_t get_option_value(AppState page, int option) {
     case STATE_TIMER: values = &timer_values; break;
     case STATE_TLAPSE: values = &tlapse_values; break;
     case STATE_INTERVAL: values = &interval_values; break;
+    case STATE_BURST: values = &burst_values; break;
     default: return 0;
   }
   
-  return (option == 0) ? values->option1.seconds : values->option2.seconds;
+  return page_option(values, option)->value;
+}
+
+int page_option_count(AppState page) {
+  switch (page) {
+    case STATE_TIMER:    return 2;
+    case STATE_TLAPSE:   return 3;
+    case STATE_INTERVAL: return 1;
+    case STATE_BURST:    return 3;
+    default:             return 0;
+  }
+}
+
+OptionValue* page_option(PageValues *values, int option) {
+  switch (option) {
+    case 0:  return &values->option1;
+    case 1:  return &values->option2;
+    default: return &values->option3;
+  }
 }
 
 void update_option_value(AppState page, int option, int32_t delta) {
@@ -248,20 +379,21 @@ void update_option_value(AppState page, int option, int32_t delta) {
     case STATE_TIMER: values = &timer_values; break;
     case STATE_TLAPSE: values = &tlapse_values; break;
     case STATE_INTERVAL: values = &interval_values; break;
+    case STATE_BURST: values = &burst_values; break;
     default: return;
   }
   
-  OptionValue* target_option = (option == 0) ? &values->option1 : &values->option2;
+  OptionValue* target_option = page_option(values, option);
   
   // Special handling: Timer Release (Option 1) with Trigger Mode
   if (page == STATE_TIMER && option == 1) { // Release time
-    int32_t current_value = (int32_t)target_option->seconds;
+    int32_t current_value = (int32_t)target_option->value;
     
     // Handle Trigger Mode (-1)
     if (current_value == -1) {
       if (delta > 0) {
         // From Trigger up = to 00:00
-        target_option->seconds = 0;
+        target_option->value = 0;
         DEBUG_PRINTLN("Switched from Trigger to 00:00");
       } else {
         // From Trigger down = BLOCKED
@@ -275,21 +407,27 @@ void update_option_value(AppState page, int option, int32_t delta) {
       
       if (new_value < 0) {
         // Scroll below 0 = to Trigger
-        target_option->seconds = (uint32_t)-1;
+        target_option->value = (uint32_t)-1;
         DEBUG_PRINTLN("Switched from 00:00 to Trigger mode");
       } else if (new_value > target_option->max_value) {
-        target_option->seconds = target_option->max_value;
+        target_option->value = target_option->max_value;
       } else {
-        target_option->seconds = (uint32_t)new_value;
+        target_option->value = (uint32_t)new_value;
       }
     } else {
       DEBUG_PRINTF("ERROR: Invalid timer release value: %d, resetting to 0\n", current_value);
-      target_option->seconds = 0;
+      target_option->value = 0;
     }
   } 
   // Normal handling for all other options
   else {
-    int64_t new_value = (int64_t)target_option->seconds + (delta * target_option->increment);
+    // Schrittweite wächst mit dem Wert - beim Runterdrehen zählt die Stufe darunter
+    uint32_t reference = (delta < 0 && target_option->value > 0) ? target_option->value - 1 : target_option->value;
+    uint32_t step = option_step(*target_option, reference);
+    int64_t new_value = (int64_t)target_option->value + (int64_t)delta * step;
+    
+    // Auf das Raster der neuen Stufe einrasten (z.B. 59:59 + 1 min -> 1h00m)
+    if (new_value > 0) new_value -= new_value % option_step(*target_option, (uint32_t)new_value);
     
     // Apply bounds checking
     if (new_value < target_option->min_value) {
@@ -298,38 +436,50 @@ void update_option_value(AppState page, int option, int32_t delta) {
       new_value = target_option->max_value;
     }
     
-    target_option->seconds = (uint32_t)new_value;
+    target_option->value = (uint32_t)new_value;
   }
   
-  // Special logic for T-Lapse frames: max 1 frame per second
+  // Special logic for T-Lapse frames: max so viele Frames, wie Servo/Elektro schaffen
   if (page == STATE_TLAPSE && option == 1) {
-    uint32_t total_time_seconds = values->option1.seconds;
-    if (values->option2.seconds > total_time_seconds) {
-      values->option2.seconds = total_time_seconds;
-      DEBUG_PRINTF("Frame count auto-adjusted to %d (max 1 frame per second)\n", total_time_seconds);
+    uint32_t max_frames = tlapse_max_frames(values->option1.value);
+    if (values->option2.value > max_frames) {
+      values->option2.value = max_frames;
+      DEBUG_PRINTF("Frame count auto-adjusted to %d (actuator rate limit)\n", max_frames);
     }
-    values->option2.max_value = total_time_seconds;
+    values->option2.max_value = max_frames;
   }
   
   // If we changed T-Lapse total time, adjust frame count
   if (page == STATE_TLAPSE && option == 0) {
-    uint32_t total_time = target_option->seconds;
-    if (values->option2.seconds > total_time) {
-      values->option2.seconds = total_time;
-      DEBUG_PRINTF("Frame count auto-adjusted to %d (max 1 frame per second)\n", total_time);
+    uint32_t max_frames = tlapse_max_frames(target_option->value);
+    if (values->option2.value > max_frames) {
+      values->option2.value = max_frames;
+      DEBUG_PRINTF("Frame count auto-adjusted to %d (actuator rate limit)\n", max_frames);
+    }
+    values->option2.max_value = max_frames;
+  }
+  
+  // Burst: Pulsbreite folgt der Rate (Impuls + BURST_MIN_GAP_MS pro Periode)
+  if (page == STATE_BURST) {
+    values->option3.max_value = burst_max_pulse_ms(values->option2.value);
+    if (values->option3.value > values->option3.max_value) {
+      values->option3.value = values->option3.max_value;
+      DEBUG_PRINTF("Burst pulse auto-adjusted to %d ms (rate %d Hz)\n", values->option3.value, values->option2.value);
     }
-    values->option2.max_value = total_time;
   }
   
   DEBUG_PRINTF("Updated %s option %d: %s\n", 
                values->page_title.c_str(), 
                option + 1,
-               format_time_value(target_option->seconds, target_option->format).c_str());
+               format_time_value(target_option->value, target_option->format).c_str());
   
   update_page_content_from_values(page);
 
   // Auto-save after value change
-  if (settings_initialized) {
+  if (page == STATE_BURST) {
+    // Prüft burst_config_valid und schreibt app_state
+    set_burst_config(values->option1.value, values->option2.value, values->option3.value);
+  } else if (settings_initialized) {
     save_timer_values(); // Only save timer values for performance
   }
 
@@ -352,6 +502,10 @@ void update_page_content_from_values(AppState page) {
       values = &interval_values;
       content = &interval_content;
       break;
+    case STATE_BURST:
+      values = &burst_values;
+      content = &burst_content;
+      break;
     default:
       return;
   }
@@ -359,17 +513,28 @@ void update_page_content_from_values(AppState page) {
   content->heading = values->page_title;
   content->option1_text = values->option1_label;
   content->option2_text = values->option2_label;
-  content->option1_time = format_time_value(values->option1.seconds, values->option1.format);
+  content->option3_text = values->option3_label;
+  content->option3_time = values->option3_label.isEmpty() ? "" : 
+                          format_time_value(values->option3.value, values->option3.format);
+  content->option1_time = format_time_value(values->option1.value, values->option1.format);
   
   // Special handling for different pages
   if (page == STATE_INTERVAL) {
     content->option2_text = "";   // Interval has no second option
     content->option2_time = "";   // Empty
   } else {
-    content->option2_time = format_time_value(values->option2.seconds, values->option2.format);
+    content->option2_time = format_time_value(values->option2.value, values->option2.format);
   }
 }
 
+void burst_values_from_state() {
+  burst_values.option1 = {(uint32_t)app_state.burst_count, VALUE_FORMAT_COUNT, 1, BURST_MAX_COUNT, 1};
+  burst_values.option2 = {(uint32_t)app_state.burst_rate_hz, VALUE_FORMAT_HZ, 1, BURST_MAX_RATE_HZ, 1};
+  burst_values.option3 = {(uint32_t)app_state.burst_pulse_ms, VALUE_FORMAT_PULSE_MS, BURST_MIN_PULSE_MS,
+                          burst_max_pulse_ms(app_state.burst_rate_hz), 1};
+  update_page_content_from_values(STATE_BURST);
+}
+
 // =============================================================================
 // STATE MANAGEMENT IMPLEMENTATION - SIMPLIFIED
 // =============================================================================
@@ -422,6 +587,7 @@ AppState get_parent_state(AppState current_state) {
       return STATE_MAIN;
     
     case STATE_WIRE_SETTINGS:  
+    case STATE_BURST:
       return STATE_SETTINGS;
 
     case STATE_MAIN:
@@ -432,7 +598,7 @@ AppState get_parent_state(AppState current_state) {
 }
 
 bool is_main_template_state(AppState state) {
-  return (state == STATE_TIMER || state == STATE_TLAPSE || state == STATE_INTERVAL);
+  return (state == STATE_TIMER || state == STATE_TLAPSE || state == STATE_INTERVAL || state == STATE_BURST);
 }
 
 void check_loading_timeout() {
@@ -456,6 +622,7 @@ PageContent get_current_content() {
     case STATE_TIMER: return timer_content;
     case STATE_TLAPSE: return tlapse_content;
     case STATE_INTERVAL: return interval_content;
+    case STATE_BURST: return burst_content;
     default: return timer_content;
   }
 }
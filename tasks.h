@@ -0,0 +1,273 @@
+/*
+=============================================================================
+tasks.h - FreeRTOS-Tasks: Control, UI, Housekeeping
+=============================================================================
+Die Flanken selbst feuert die One-Shot-Uhr im esp_timer-Task (trigger_clock.h).
+Alles andere lief bisher hintereinander in loop() - ein Redraw, ein I2C-Read
+oder ein NVS-Write verzögerte so auch Servo-Init, Fallback-Dispatch und
+Fortschritt. Aufteilung:
+  - Control (hohe Priorität, unter esp_timer und externem Trigger):
+    timer_system_control_update() - Servo-Init, Fallback-Dispatch, Fortschritt.
+    Schläft bis zur Task-Notification (Dispatch mit neuem Frame/Zustand, Start,
+    Abbruch) bzw. bis zum Ende der Servo-Init. Nur ohne Hardware-Timer pollt
+    er alle CONTROL_TASK_PERIOD_MS für den Fallback-Dispatch.
+  - UI (Arduino-loopTask, leicht angehoben): einziger Task, der LVGL anfasst -
+    lv_timer_handler, Encoder, Serial, Overlays, BLE-Anzeige, Akku-Widgets.
+  - Housekeeping (niedrigste Priorität): Fuel-Gauge/GPIO lesen, NVS-Writes
+    der Einstellungen, Checkpoints, Log-Ausgabe.
+Die Tasks reden nur über begrenzte Queues: Housekeeping-Aufträge
+(Persistenz, Log) und ein Akku-Sample als Mailbox (Länge 1, nur das neueste
+zählt). Laufen die Tasks nicht (Deep-Sleep-Hot-Path, Host, Create-Fehler),
+erledigt app_loop() alles wie bisher selbst.
+=============================================================================
+*/
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "settings.h"
+#include "battery.h"
+#include "timer_system.h"
+#include "checkpoint.h"
+
+#if defined(ESP32)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#endif
+
+// =============================================================================
+// TASK CONFIGURATION
+// =============================================================================
+#define CONTROL_TASK_PRIORITY       (configMAX_PRIORITIES - 5)   // esp_timer 22, ext_trigger 23
+#define UI_TASK_PRIORITY            2                            // loopTask, sonst 1
+#define HOUSEKEEPING_TASK_PRIORITY  1
+#define CONTROL_TASK_STACK          3072
+#define HOUSEKEEPING_TASK_STACK     4096
+#define CONTROL_TASK_PERIOD_MS      10     // Nur ohne Hardware-Timer (Fallback-Dispatch)
+#define HOUSEKEEPING_PERIOD_MS      100    // Max. Wartezeit auf Aufträge, dann Akku/Checkpoint
+#define HOUSEKEEPING_QUEUE_DEPTH    16
+
+// Aufträge an den Housekeeping-Task
+enum HousekeepingMsgType {
+  HK_PERSIST,      // value = PersistRequest
+  HK_LOG           // kind = ProgressLogType, value = Zähler
+};
+
+struct HousekeepingMsg {
+  uint8_t type;
+  uint8_t kind;
+  int32_t value;
+};
+
+struct TaskStats {
+  uint32_t persist_merged;     // Persistenz-Anfragen, die schon anstanden
+  uint32_t dropped;            // Queue voll - verworfen
+  uint32_t battery_samples;
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+bool tasks_start();                  // Nach app_init_ui() - false = alles bleibt in loop()
+bool control_running();
+bool housekeeping_running();
+void control_notify();               // Control-Task wecken (neuer Frame, Zustandswechsel)
+bool housekeeping_persist(uint8_t request);
+bool housekeeping_log(uint8_t type, int32_t value);
+bool battery_sample_receive(BatterySample &sample);
+void housekeeping_handle(const HousekeepingMsg &msg);
+void housekeeping_step();
+void print_task_status();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+TaskStats task_stats = {0, 0, 0};
+volatile bool tasks_battery_active = false;   // Akku erst nach dem Loading Screen abfragen
+volatile uint8_t housekeeping_persist_pending = 0;   // Bit je PersistRequest - gleiche Anfragen zusammenfassen
+
+#if defined(ESP32)
+TaskHandle_t control_task_handle = nullptr;
+TaskHandle_t housekeeping_task_handle = nullptr;
+QueueHandle_t housekeeping_queue = nullptr;
+QueueHandle_t battery_sample_queue = nullptr;
+portMUX_TYPE housekeeping_mux = portMUX_INITIALIZER_UNLOCKED;
+
+TickType_t control_wait_ticks() {
+#if TRIGGER_CLOCK_HARDWARE
+  if (trigger_clock_timer) {
+    // Flanken feuert die One-Shot-Uhr - alles Weitere meldet control_notify()
+    if (servo_initialization_complete) return portMAX_DELAY;
+    if (servo_init_start_time == 0) return 0;
+    unsigned long elapsed = millis() - servo_init_start_time;
+    if (elapsed >= SERVO_INIT_TIME_MS) return 0;
+    return pdMS_TO_TICKS(SERVO_INIT_TIME_MS - elapsed) + 1;
+  }
+#endif
+  // Kein Hardware-Timer: der Fallback-Dispatch braucht das Raster
+  return pdMS_TO_TICKS(CONTROL_TASK_PERIOD_MS);
+}
+
+void control_task(void *arg) {
+  for (;;) {
+    timer_system_control_update();
+    ulTaskNotifyTake(pdTRUE, control_wait_ticks());
+  }
+}
+
+void housekeeping_task(void *arg) {
+  HousekeepingMsg msg;
+  for (;;) {
+    if (xQueueReceive(housekeeping_queue, &msg, pdMS_TO_TICKS(HOUSEKEEPING_PERIOD_MS)) == pdTRUE) {
+      housekeeping_handle(msg);
+    }
+    housekeeping_step();
+  }
+}
+
+bool tasks_start() {
+  housekeeping_queue = xQueueCreate(HOUSEKEEPING_QUEUE_DEPTH, sizeof(HousekeepingMsg));
+  battery_sample_queue = xQueueCreate(1, sizeof(BatterySample));
+  if (!housekeeping_queue || !battery_sample_queue) {
+    DEBUG_PRINTLN("ERROR: Task queues could not be created - single loop");
+    return false;
+  }
+
+  // Der Arduino-loopTask wird zum UI-Task
+  vTaskPrioritySet(NULL, UI_TASK_PRIORITY);
+
+  if (xTaskCreate(control_task, "control", CONTROL_TASK_STACK, nullptr, CONTROL_TASK_PRIORITY,
+                  &control_task_handle) != pdPASS) {
+    control_task_handle = nullptr;
+    DEBUG_PRINTLN("ERROR: Control task could not be created - control stays in loop");
+  }
+  if (xTaskCreate(housekeeping_task, "housekeeping", HOUSEKEEPING_TASK_STACK, nullptr,
+                  HOUSEKEEPING_TASK_PRIORITY, &housekeeping_task_handle) != pdPASS) {
+    housekeeping_task_handle = nullptr;
+    DEBUG_PRINTLN("ERROR: Housekeeping task could not be created - housekeeping stays in loop");
+  }
+
+  DEBUG_PRINTF("Tasks started: control %s (prio %d), UI loop (prio %d), housekeeping %s (prio %d)\n",
+               control_task_handle ? "OK" : "FAILED", CONTROL_TASK_PRIORITY, UI_TASK_PRIORITY,
+               housekeeping_task_handle ? "OK" : "FAILED", HOUSEKEEPING_TASK_PRIORITY);
+  return control_task_handle && housekeeping_task_handle;
+}
+
+bool control_running() {
+  return control_task_handle != nullptr;
+}
+
+bool housekeeping_running() {
+  return housekeeping_task_handle != nullptr;
+}
+
+void control_notify() {
+  if (control_task_handle) xTaskNotifyGive(control_task_handle);
+}
+
+bool housekeeping_persist(uint8_t request) {
+  if (!housekeeping_task_handle) return false;
+
+  // Steht derselbe Auftrag schon an, schreibt der ohnehin den neuesten Stand
+  portENTER_CRITICAL(&housekeeping_mux);
+  bool pending = housekeeping_persist_pending & (1 << request);
+  housekeeping_persist_pending |= (1 << request);
+  portEXIT_CRITICAL(&housekeeping_mux);
+  if (pending) {
+    task_stats.persist_merged++;
+    return true;
+  }
+
+  HousekeepingMsg msg = {HK_PERSIST, 0, request};
+  if (xQueueSend(housekeeping_queue, &msg, 0) != pdTRUE) {
+    // Queue voll - lieber hier schreiben als die Einstellung verlieren
+    portENTER_CRITICAL(&housekeeping_mux);
+    housekeeping_persist_pending &= ~(1 << request);
+    portEXIT_CRITICAL(&housekeeping_mux);
+    task_stats.dropped++;
+    return false;
+  }
+  return true;
+}
+
+bool housekeeping_log(uint8_t type, int32_t value) {
+  if (!housekeeping_task_handle) return false;
+  HousekeepingMsg msg = {HK_LOG, type, value};
+  if (xQueueSend(housekeeping_queue, &msg, 0) != pdTRUE) task_stats.dropped++;   // Log darf fehlen
+  return true;
+}
+
+bool battery_sample_receive(BatterySample &sample) {
+  return battery_sample_queue && xQueueReceive(battery_sample_queue, &sample, 0) == pdTRUE;
+}
+
+void housekeeping_publish_battery(const BatterySample &sample) {
+  xQueueOverwrite(battery_sample_queue, &sample);
+  low_power_wake_loop();   // UI übernimmt das Sample sofort
+}
+
+#else
+bool tasks_start() { return false; }
+bool control_running() { return false; }
+bool housekeeping_running() { return false; }
+void control_notify() {}
+bool housekeeping_persist(uint8_t request) { return false; }
+bool housekeeping_log(uint8_t type, int32_t value) { return false; }
+bool battery_sample_receive(BatterySample &sample) { return false; }
+void housekeeping_publish_battery(const BatterySample &sample) {}
+#endif
+
+void housekeeping_handle(const HousekeepingMsg &msg) {
+  if (msg.type == HK_LOG) {
+    print_progress_log(msg.kind, msg.value);
+    return;
+  }
+
+  // Bit vor dem Schreiben löschen - spätere Änderungen lösen einen neuen Write aus
+#if defined(ESP32)
+  portENTER_CRITICAL(&housekeeping_mux);
+  housekeeping_persist_pending &= ~(1 << msg.value);
+  portEXIT_CRITICAL(&housekeeping_mux);
+#endif
+  switch (msg.value) {
+    case PERSIST_SETTINGS:     save_settings_now(); break;
+    case PERSIST_APP_STATE:    save_app_state_now(); break;
+    case PERSIST_TIMER_VALUES: save_timer_values_now(); break;
+  }
+}
+
+void housekeeping_step() {
+  // Fuel-Gauge per I2C - das UI bekommt nur das fertige Sample
+  if (tasks_battery_active && battery_sample_due()) {
+    BatterySample sample;
+    battery_read_sample(sample);
+    housekeeping_publish_battery(sample);
+    task_stats.battery_samples++;
+  }
+  checkpoint_update();
+}
+
+void print_task_status() {
+  Serial.println("=== Tasks ===");
+#if defined(ESP32)
+  Serial.printf("Control:      %s, prio %d, stack free %u\n", control_task_handle ? "running" : "off",
+                CONTROL_TASK_PRIORITY,
+                control_task_handle ? (unsigned)uxTaskGetStackHighWaterMark(control_task_handle) : 0);
+  Serial.printf("UI (loop):    prio %d, stack free %u\n", (int)uxTaskPriorityGet(NULL),
+                (unsigned)uxTaskGetStackHighWaterMark(NULL));
+  Serial.printf("Housekeeping: %s, prio %d, stack free %u, queue %u/%d\n",
+                housekeeping_task_handle ? "running" : "off", HOUSEKEEPING_TASK_PRIORITY,
+                housekeeping_task_handle ? (unsigned)uxTaskGetStackHighWaterMark(housekeeping_task_handle) : 0,
+                housekeeping_queue ? (unsigned)uxQueueMessagesWaiting(housekeeping_queue) : 0,
+                HOUSEKEEPING_QUEUE_DEPTH);
+#endif
+  Serial.printf("Persist merged %lu, dropped %lu, battery samples %lu\n",
+                (unsigned long)task_stats.persist_merged, (unsigned long)task_stats.dropped,
+                (unsigned long)task_stats.battery_samples);
+  Serial.println("=============");
+}
+
+#endif // TASKS_H
@@ -0,0 +1,205 @@
+/*
+=============================================================================
+host_scheduler_test.cpp - Host-Test für Trigger-Uhr und Scheduler
+=============================================================================
+Läuft ohne ESP32 und ohne Arduino-Framework gegen die Host-Uhr aus
+trigger_clock.h:
+
+  g++ -std=gnu++17 -I. tests/host_scheduler_test.cpp -o host_scheduler_test
+  ./host_scheduler_test
+
+Geprüft werden Heap-Reihenfolge (inkl. FIFO bei gleicher Deadline),
+Nachstellen der One-Shot-Uhr bei neuem Queue-Kopf, time_reached() jenseits
+der alten 32-Bit-Grenzen, die Bresenham-Verteilung der T-Lapse-Frames und
+die Drift-Umrechnung und -Messung von Wall Clock und Time Sync.
+Exit-Code 0 = alles bestanden.
+=============================================================================
+*/
+
+#include "trigger_clock.h"
+#include "scheduler.h"
+
+#include <stdio.h>
+
+// =============================================================================
+// TEST HELPERS
+// =============================================================================
+int test_failures = 0;
+
+#define CHECK(cond) do { \
+  if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); test_failures++; } \
+} while (0)
+
+// Dispatch wie in timer_system.h: alles Fällige abholen, dann neu armieren
+ScheduledEvent fired[SCHEDULER_QUEUE_SIZE];
+uint64_t fired_at[SCHEDULER_QUEUE_SIZE];
+uint8_t fired_count = 0;
+
+void test_dispatch() {
+  ScheduledEvent event;
+  while (scheduler_pop_due(trigger_clock_now_us(), event)) {
+    fired_at[fired_count] = trigger_clock_now_us();
+    fired[fired_count++] = event;
+  }
+  scheduler_rearm();
+}
+
+void test_reset() {
+  trigger_clock_init(test_dispatch);
+  trigger_clock_host_set(0);
+  scheduler_clear();
+  fired_count = 0;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+void test_heap_ordering() {
+  test_reset();
+  const uint64_t deadlines[] = {500, 100, 900, 300, 700, 100, 200};
+  for (uint8_t i = 0; i < 7; i++) {
+    CHECK(scheduler_push(EVENT_RELEASE_START, deadlines[i], i));
+  }
+  CHECK(scheduler_count() == 7);
+
+  ScheduledEvent event;
+  uint64_t last = 0;
+  uint8_t popped = 0;
+  while (scheduler_pop_due(UINT64_MAX, event)) {
+    CHECK(event.deadline >= last);
+    // Gleiche Deadline: zuerst eingeplant, zuerst gefeuert (Kanal = Einplan-Index)
+    if (event.deadline == 100) CHECK(event.channel == (popped == 0 ? 1 : 5));
+    last = event.deadline;
+    popped++;
+  }
+  CHECK(popped == 7);
+  CHECK(scheduler_count() == 0);
+
+  // Volle Queue verwirft, statt zu überschreiben
+  for (uint8_t i = 0; i < SCHEDULER_QUEUE_SIZE; i++) scheduler_push(EVENT_RELEASE_END, 1000 + i);
+  CHECK(!scheduler_push(EVENT_RELEASE_END, 1));
+  CHECK(scheduler_count() == SCHEDULER_QUEUE_SIZE);
+}
+
+void test_rearm_on_new_head() {
+  test_reset();
+  scheduler_push(EVENT_RELEASE_START, 10000);
+  CHECK(trigger_clock_host_armed && trigger_clock_host_deadline == 10000);
+
+  // Späteres Event ändert den Kopf nicht
+  scheduler_push(EVENT_RELEASE_END, 20000);
+  CHECK(trigger_clock_host_deadline == 10000);
+
+  // Früheres Event wird neuer Kopf -> Uhr wird vorgezogen
+  scheduler_push(EVENT_FOCUS_START, 5000);
+  CHECK(trigger_clock_host_deadline == 5000);
+
+  // Entfernen des Kopfs stellt auf den nächsten zurück
+  scheduler_remove(EVENT_FOCUS_START);
+  CHECK(trigger_clock_host_deadline == 10000);
+
+  // Die Uhr feuert jedes Event genau zu seiner Deadline, nicht früher
+  trigger_clock_host_set(9999);
+  CHECK(fired_count == 0);
+  trigger_clock_host_set(10000);
+  CHECK(fired_count == 1 && fired[0].type == EVENT_RELEASE_START && fired_at[0] == 10000);
+  CHECK(trigger_clock_host_deadline == 20000);
+  trigger_clock_host_advance(50000);
+  CHECK(fired_count == 2 && fired[1].type == EVENT_RELEASE_END);
+  CHECK(!trigger_clock_host_armed);
+}
+
+void test_time_reached_wrap() {
+  // 32-Bit-µs liefen nach 71,6 min über, millis() nach 49,7 Tagen
+  const uint64_t wrap_us32 = 0x100000000ULL;
+  const uint64_t wrap_ms32 = 0x100000000ULL * 1000ULL;
+  CHECK(!time_reached(wrap_us32 - 1, wrap_us32 + 5));
+  CHECK(time_reached(wrap_us32 + 5, wrap_us32 + 5));
+  CHECK(time_reached(wrap_us32 + 6, wrap_us32 - 1));
+  CHECK(!time_reached(wrap_ms32 - 1000, wrap_ms32 + 1000));
+  CHECK(time_reached(wrap_ms32 + 1000, wrap_ms32 + 1000));
+
+  // Uhr fortsetzen (Deep-Sleep/Reset) und über die 32-Bit-Grenze dispatchen
+  test_reset();
+  trigger_clock_continue_from(wrap_us32 - 10);
+  scheduler_push(EVENT_RELEASE_START, wrap_us32 + 10);
+  trigger_clock_host_advance(15);
+  CHECK(fired_count == 0);
+  trigger_clock_host_advance(5);
+  CHECK(fired_count == 1 && fired_at[0] == wrap_us32 + 10);
+}
+
+void test_bresenham_spread() {
+  const unsigned long totals[] = {1000, 60000, 3600000, 7, 86400000UL};
+  const uint32_t frame_counts[] = {3, 7, 997, 7, 1440};
+  for (uint8_t t = 0; t < 5; t++) {
+    FramePlan plan;
+    frame_plan_init(plan, totals[t], frame_counts[t]);
+    unsigned long offset = 0, previous = 0;
+    uint32_t frames = 0;
+    while (frame_plan_next(plan, offset)) {
+      frames++;
+      // Exakt floor(k * total / frames) - keine Fehlerakkumulation
+      CHECK(offset == frame_plan_offset(plan, frames));
+      unsigned long gap = offset - previous;
+      CHECK(gap == plan.step_ms || gap == plan.step_ms + 1);
+      previous = offset;
+    }
+    CHECK(frames == frame_counts[t]);
+    CHECK(offset == totals[t]);   // Letzter Frame genau am Ende
+  }
+
+  FramePlan empty;
+  frame_plan_init(empty, 1000, 0);
+  unsigned long offset;
+  CHECK(!frame_plan_next(empty, offset));
+}
+
+void test_drift_helpers() {
+  const int64_t hour_us = 3600LL * 1000000;
+  CHECK(drift_us(hour_us, 1000) == 3600);           // 1 ppm -> 3,6 ms/h
+  CHECK(drift_us(hour_us, -250000) == -900000);
+  CHECK(drift_us(1500000, 2000000) == 3000);       // Rest unter 1 s zählt mit
+
+  // 30 Tage bei 5000 ppm: kein Überlauf
+  const int64_t month_us = 30LL * 86400 * 1000000;
+  CHECK(drift_us(month_us, 5000000) == month_us / 200);
+
+  // Umkehrung bis zum Glied zweiter Ordnung: Rest d^3 * Spanne, bei 5000 ppm 10,8 ms/Tag
+  const int64_t day_us = 86400LL * 1000000;
+  const int32_t ppbs[] = {5000000, -5000000, 123456, 0};
+  for (uint8_t i = 0; i < 4; i++) {
+    int64_t skewed = day_us + drift_us(day_us, ppbs[i]);
+    int64_t back = drift_inverse_us(skewed, ppbs[i]);
+    CHECK(back - day_us <= 10800 && day_us - back <= 10800);
+  }
+  // Realistische RTC-Drift (500 ppm): unter 11 µs/Tag
+  int64_t back = drift_inverse_us(day_us + drift_us(day_us, 500000), 500000);
+  CHECK(back - day_us <= 11 && day_us - back <= 11);
+
+  // Messung: unplausible Sprünge (Masterwechsel, Bedienfehler) ohne Überlauf erkennen
+  const int64_t minute_us = 60LL * 1000000;
+  CHECK(drift_plausible(30000, minute_us, 500));          // 500 ppm genau an der Grenze
+  CHECK(!drift_plausible(30001, minute_us, 500));
+  CHECK(!drift_plausible(-10LL * 1000000, minute_us, 500));
+  CHECK(!drift_plausible(3LL * hour_us, hour_us, 5000));   // Uhr um 3 h verstellt
+  CHECK(!drift_plausible(INT64_MIN, month_us, 5000));
+  CHECK(drift_measure_ppb(3600, hour_us) == 1000);
+  CHECK(drift_measure_ppb(-30000, minute_us) == -500000);
+  CHECK(drift_measure_ppb(month_us / 200, month_us) == 5000000);
+}
+
+int main() {
+  test_heap_ordering();
+  test_rearm_on_new_head();
+  test_time_reached_wrap();
+  test_bresenham_spread();
+  test_drift_helpers();
+
+  if (test_failures) {
+    printf("%d check(s) failed\n", test_failures);
+    return 1;
+  }
+  printf("host_scheduler_test: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*
+=============================================================================
+time_sync.h - Zeitabgleich mehrerer Geräte gegen einen Master (NTP-Verfahren)
+=============================================================================
+Mehrere RS1 an verschiedenen Kameras sollen im selben Moment auslösen. Der
+Master (Handy-App oder Host am USB-Serial) gibt die Zeitbasis vor, das Gerät
+misst seinen Versatz dazu mit NTP-artigen Runden:
+
+  Gerät  -> Master  SYNC_REQ:<t1>            t1 = Gerätezeit beim Senden
+  Master -> Gerät   SYNC:<t1>:<t2>:<t3>      t2/t3 = Masterzeit Empfang/Antwort
+                                             t4 = Gerätezeit beim Empfang
+
+  Versatz = ((t2 - t1) + (t3 - t4)) / 2      Laufzeit = (t4 - t1) - (t3 - t2)
+
+Eine Runde besteht aus TIMESYNC_BURST Messungen - übernommen wird die mit
+der kürzesten Laufzeit (BLE-Verbindungsintervalle machen die anderen
+asymmetrisch). Liegen zwei Runden mindestens TIMESYNC_MIN_DRIFT_S
+auseinander, ergibt die Änderung des Versatzes die Drift des Quarzes
+gegenüber dem Master. Versatz und Drift bilden Masterzeit auf die
+Trigger-Zeitbasis ab - ein synchronisierter Lauf rechnet jede Deadline über
+diese Abbildung, spätere Runden korrigieren also auch laufende Pläne.
+Der Zustand liegt im RTC-Speicher und überlebt Deep-Sleep (die Trigger-Zeit
+läuft dort weiter), nach einem Reset ist er ungültig.
+=============================================================================
+*/
+
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "trigger_clock.h"
+
+#if defined(ESP32)
+#include "esp_system.h"
+#endif
+
+// =============================================================================
+// TIME SYNC STATE
+// =============================================================================
+#define TIMESYNC_MAGIC        0x52535453   // "RSTS"
+
+enum TimeSyncResult {
+  TIMESYNC_NEXT,          // Runde läuft - nächste Anfrage senden
+  TIMESYNC_DONE,          // Runde abgeschlossen, Versatz übernommen
+  TIMESYNC_REJECTED       // Antwort passt zu keiner offenen Anfrage oder Laufzeit zu lang
+};
+
+// Masterzeit = local + offset_us + Drift über (local - ref_local_us)
+struct TimeSyncState {
+  uint32_t magic;
+  int64_t offset_us;          // Masterzeit - Trigger-Zeit am Referenzpunkt
+  uint64_t ref_local_us;
+  int32_t drift_ppb;          // > 0: Master läuft schneller als die Trigger-Zeitbasis
+  bool drift_valid;
+  int64_t cal_offset_us;      // Anker der Drift-Messung
+  uint64_t cal_local_us;
+  uint32_t delay_us;          // Laufzeit der übernommenen Messung
+  uint32_t rounds;
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void time_sync_init();
+void time_sync_reset();
+bool time_sync_valid();
+uint64_t time_sync_next_request();                  // Neue Anfrage, liefert t1
+uint64_t time_sync_begin();                         // Neue Runde, liefert t1 der ersten Anfrage
+uint8_t time_sync_sample(uint64_t t1, int64_t t2, int64_t t3, uint64_t t4);   // TimeSyncResult
+int64_t time_sync_drift_us(int64_t span_us);
+int64_t time_sync_master_now_us();
+uint64_t time_sync_master_to_local(int64_t master_us);
+bool time_sync_start_at(int64_t master_us, TimerExecutionMode mode);   // false = nicht synchron/belegt
+String time_sync_int64(int64_t value);
+String time_sync_status_string();                   // BLE: <valid>:<offset_us>:<drift_ppb>:<delay_us>:<age_s>
+void print_time_sync_status();
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+RTC_DATA_ATTR TimeSyncState time_sync_state;
+
+// Laufende Runde
+uint64_t time_sync_pending_t1 = 0;
+uint8_t time_sync_burst_count = 0;
+int64_t time_sync_best_offset = 0;
+uint64_t time_sync_best_local = 0;
+int64_t time_sync_best_delay = -1;
+
+void time_sync_init() {
+#if defined(ESP32)
+  if (esp_reset_reason() != ESP_RST_DEEPSLEEP) {
+    // Trigger-Zeitbasis beginnt neu - alter Versatz passt nicht mehr
+    time_sync_state.magic = 0;
+  }
+#endif
+  DEBUG_PRINTF("Time sync: %s\n", time_sync_valid() ? "kept from before deep sleep" : "not synced");
+}
+
+void time_sync_reset() {
+  time_sync_state.magic = 0;
+  time_sync_pending_t1 = 0;
+  time_sync_burst_count = 0;
+  DEBUG_PRINTLN("Time sync: reset");
+}
+
+bool time_sync_valid() {
+  return time_sync_state.magic == TIMESYNC_MAGIC;
+}
+
+uint64_t time_sync_next_request() {
+  time_sync_pending_t1 = trigger_clock_now_us();
+  return time_sync_pending_t1;
+}
+
+uint64_t time_sync_begin() {
+  time_sync_burst_count = 0;
+  time_sync_best_delay = -1;
+  return time_sync_next_request();
+}
+
+int64_t time_sync_drift_us(int64_t span_us) {
+  return drift_us(span_us, time_sync_state.drift_ppb);
+}
+
+void time_sync_commit() {
+  uint64_t local = time_sync_best_local;
+  int64_t offset = time_sync_best_offset;
+
+  if (time_sync_valid()) {
+    // Vorhersage der bisherigen Abbildung gegen die neue Messung
+    int64_t error_us = time_sync_state.offset_us + time_sync_drift_us((int64_t)(local - time_sync_state.ref_local_us)) -
+                       offset;
+    int64_t span = (int64_t)(local - time_sync_state.cal_local_us);
+    DEBUG_PRINTF("Time sync: prediction was %ld us off\n", (long)error_us);
+
+    if (span >= (int64_t)TIMESYNC_MIN_DRIFT_S * 1000000) {
+      int64_t delta = offset - time_sync_state.cal_offset_us;
+      if (!drift_plausible(delta, span, TIMESYNC_MAX_DRIFT_PPM)) {
+        // Mehr als ein Quarz driften kann: anderer Master oder gestellte Uhr - neu anfangen
+        DEBUG_PRINTF("Time sync: offset moved %s us in %lu s - new master, drift reset\n",
+                     time_sync_int64(delta).c_str(), (unsigned long)(span / 1000000));
+        time_sync_state.drift_ppb = 0;
+        time_sync_state.drift_valid = false;
+      } else {
+        int32_t measured = drift_measure_ppb(delta, span);
+        time_sync_state.drift_ppb = time_sync_state.drift_valid ?
+                                    (int32_t)(((int64_t)time_sync_state.drift_ppb + (int64_t)measured * 3) / 4) : measured;
+        time_sync_state.drift_valid = true;
+        DEBUG_PRINTF("Time sync: drift measured %ld ppb over %lu s -> using %ld ppb\n",
+                     (long)measured, (unsigned long)(span / 1000000), (long)time_sync_state.drift_ppb);
+      }
+      time_sync_state.cal_offset_us = offset;
+      time_sync_state.cal_local_us = local;
+    }
+  } else {
+    time_sync_state.drift_ppb = 0;
+    time_sync_state.drift_valid = false;
+    time_sync_state.cal_offset_us = offset;
+    time_sync_state.cal_local_us = local;
+    time_sync_state.rounds = 0;
+  }
+
+  time_sync_state.offset_us = offset;
+  time_sync_state.ref_local_us = local;
+  time_sync_state.delay_us = (uint32_t)time_sync_best_delay;
+  time_sync_state.rounds++;
+  time_sync_state.magic = TIMESYNC_MAGIC;
+
+  DEBUG_PRINTF("Time sync: offset %s us, round trip %lu us\n", time_sync_int64(offset).c_str(),
+               (unsigned long)time_sync_state.delay_us);
+}
+
+uint8_t time_sync_sample(uint64_t t1, int64_t t2, int64_t t3, uint64_t t4) {
+  if (t1 == 0 || t1 != time_sync_pending_t1 || t4 < t1 || t3 < t2) return TIMESYNC_REJECTED;
+  time_sync_pending_t1 = 0;
+
+  int64_t delay = (int64_t)(t4 - t1) - (t3 - t2);
+  if (delay < 0) delay = 0;
+  if (delay <= (int64_t)MS_TO_US(TIMESYNC_MAX_DELAY_MS) &&
+      (time_sync_best_delay < 0 || delay < time_sync_best_delay)) {
+    // Versatz gilt für die Mitte der Runde
+    time_sync_best_offset = ((t2 - (int64_t)t1) + (t3 - (int64_t)t4)) / 2;
+    time_sync_best_local = t1 + (t4 - t1) / 2;
+    time_sync_best_delay = delay;
+  }
+
+  if (++time_sync_burst_count < TIMESYNC_BURST) return TIMESYNC_NEXT;
+  if (time_sync_best_delay < 0) {
+    DEBUG_PRINTLN("Time sync: every round trip too long - offset not updated");
+    return TIMESYNC_REJECTED;
+  }
+  time_sync_commit();
+  return TIMESYNC_DONE;
+}
+
+int64_t time_sync_master_now_us() {
+  if (!time_sync_valid()) return 0;
+  uint64_t now = trigger_clock_now_us();
+  return (int64_t)now + time_sync_state.offset_us + time_sync_drift_us((int64_t)(now - time_sync_state.ref_local_us));
+}
+
+uint64_t time_sync_master_to_local(int64_t master_us) {
+  if (!time_sync_valid()) return 0;
+  // Master-Spanne -> lokale Spanne
+  int64_t span = master_us - ((int64_t)time_sync_state.ref_local_us + time_sync_state.offset_us);
+  int64_t local = (int64_t)time_sync_state.ref_local_us + drift_inverse_us(span, time_sync_state.drift_ppb);
+  return local > 0 ? (uint64_t)local : 0;
+}
+
+bool time_sync_start_at(int64_t master_us, TimerExecutionMode mode) {
+  if (!time_sync_valid() || runtime.state != TIMER_IDLE) return false;
+
+  uint64_t start_us = time_sync_master_to_local(master_us);
+  uint64_t now = trigger_clock_now_us();
+  if (start_us <= now || start_us - now > (uint64_t)VALUE_MAX_DURATION_S * 1000000) {
+    DEBUG_PRINTLN("Synced start rejected: time is in the past or too far ahead");
+    return false;
+  }
+
+  // Deadlines des Laufs folgen ab jetzt der Masterzeit
+  timer_sync_master_us = master_us;
+  bool armed = start_execution_at(start_us, mode);
+  timer_sync_master_us = 0;
+
+  if (armed) {
+    DEBUG_PRINTF("Synced run armed for master time %s (in %lu ms)\n", time_sync_int64(master_us).c_str(),
+                 (unsigned long)US_TO_MS(start_us - now));
+  }
+  return armed;
+}
+
+String time_sync_int64(int64_t value) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%lld", (long long)value);
+  return String(buffer);
+}
+
+String time_sync_status_string() {
+  if (!time_sync_valid()) return "0";
+  return "1:" + time_sync_int64(time_sync_state.offset_us) + ":" + String(time_sync_state.drift_ppb) + ":" +
+         String(time_sync_state.delay_us) + ":" +
+         String((unsigned long)((trigger_clock_now_us() - time_sync_state.ref_local_us) / 1000000));
+}
+
+void print_time_sync_status() {
+  Serial.println("=== Time Sync ===");
+  if (!time_sync_valid()) {
+    Serial.println("Not synced (BLE SYNC or 'sync start' from the master)");
+  } else {
+    Serial.printf("Master time: %s us\n", time_sync_int64(time_sync_master_now_us()).c_str());
+    Serial.printf("Offset: %s us, round trip %lu us, %lu rounds\n", time_sync_int64(time_sync_state.offset_us).c_str(),
+                  (unsigned long)time_sync_state.delay_us, (unsigned long)time_sync_state.rounds);
+    Serial.printf("Drift: %ld ppb (%s, needs rounds >= %d s apart)\n", (long)time_sync_state.drift_ppb,
+                  time_sync_state.drift_valid ? "measured" : "not measured", TIMESYNC_MIN_DRIFT_S);
+    Serial.printf("Last round: %lu s ago\n",
+                  (unsigned long)((trigger_clock_now_us() - time_sync_state.ref_local_us) / 1000000));
+  }
+  if (runtime.state != TIMER_IDLE && runtime.syncMaster != 0) {
+    Serial.println("Running run follows the master time base");
+  }
+  Serial.println("=================");
+}
+
+#endif // TIME_SYNC_H
@@ -10,25 +10,36 @@ timer_system.h - Timer/T-Lapse/Interval System mit Servo + Elektro synchron
 #include <ESP32Servo.h>
 #include "config.h"
 #include "state_machine.h"
+#include "trigger_clock.h"
+#include "scheduler.h"
+#include "sequence.h"
+#include "camera_profiles.h"
+#include "outputs.h"
+
+#if defined(ESP32)
+#include "soc/gpio_reg.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
 
 // =============================================================================
 // ELEKTRO-MODUS CONFIGURATION - VEREINFACHT
 // =============================================================================
-#define ELEKTRO_FOCUS_PIN       5     // Optokoppler 1 (Fokus)
-#define ELEKTRO_RELEASE_PIN     6     // Optokoppler 2 (Release)
+#define LAG_SENSE_PIN           0     // X-Sync/Blitzschuh-Eingang für Lag-Messung (optional, schaltet gegen GND)
+#define LAG_MEASURE_TIMEOUT_MS  2000
+#define EXT_TRIGGER_PIN         LAG_SENSE_PIN   // Externer Trigger teilt sich die Buchse (Lichtschranke, Sensor, Kontakt)
 
 // Elektro-Modus Einstellungen (konfigurierbar)
-extern float elektro_focus_lead_time;      // Vorlaufzeit vor Release (Sekunden)
-extern float elektro_focus_duration;       // Dauer des Fokus-Signals (Sekunden)
-extern float elektro_release_duration;     // Dauer des Release-Signals für Trigger (Sekunden)
+// Fokus-Vorlauf und -Dauer: app_state.focus_lead_ms / focus_duration_ms
+extern uint32_t elektro_release_us;        // Dauer des Release-Signals für Trigger (µs, aus Kanal 1)
 
 // Elektro-Modus Status
 struct ElektroState {
   bool focus_active;
   bool release_active;
-  unsigned long focus_start_time;
-  unsigned long release_start_time;
-  unsigned long focus_scheduled_time;    // Wann Fokus starten soll
+  uint64_t focus_start_time;          // µs (trigger_clock_now_us)
+  uint64_t focus_end_time;            // Geplantes Fokus-Ende (verlängerbar)
+  uint64_t release_start_time;
 };
 
 extern ElektroState elektro_state;
@@ -36,18 +47,53 @@ extern ElektroState elektro_state;
 // =============================================================================
 // TIMER SYSTEM CONFIGURATION
 // =============================================================================
-#define SERVO_PIN 9
-
 // Servo initialization tracking
 bool servo_initialization_complete = false;
+bool timer_hardware_ready = false;   // Uhr, Scheduler, Servo und Elektro initialisiert
+bool timer_run_resumed = false;      // Lauf nach Deep-Sleep aus dem RTC-Speicher übernommen
+uint64_t timer_start_at_us = 0;      // > 0: nächster Lauf beginnt erst dann (geplanter Start, wall_clock.h)
+int64_t timer_sync_master_us = 0;    // > 0: nächster Lauf folgt der Masterzeit ab diesem Start (time_sync.h)
 unsigned long servo_init_start_time = 0;
 #define SERVO_INIT_TIME_MS 500  // Time needed for servo to reach initial position
 
+// T-Lapse/Interval: Frames, die mehr als diese Zeit überfällig sind, gelten als
+// verpasst - was dann passiert, entscheidet app_state.catchup_policy
+#define FRAME_LATE_TOLERANCE_MS 250
+#define FRAME_LOG_SIZE          32    // Ringpuffer der letzten Frame-Records
+
+// Belegtzeiten der Ausgabekanäle über die eigentliche Auslösung hinaus
+#define SERVO_RETURN_TIME_MS    300   // Rückweg Endposition -> Start
+#define ELEKTRO_RELEASE_GAP_MS  100   // Min. LOW-Zeit zwischen zwei Release-Impulsen
+
+// Ausgabekanäle der Auslösung - Index = Kanal in outputs.h
+enum ActuatorChannelId {
+  ACTUATOR_SERVO,       // Kanal 0: Hauptservo
+  ACTUATOR_ELEKTRO,     // Kanal 1: Optokoppler-Paar
+  ACTUATOR_EXTRA        // Ab hier Zusatzkanäle (Servo/Optokoppler auf freien GPIOs)
+};
+#define ACTUATOR_COUNT OUTPUT_MAX_CHANNELS
+
+// Pipeline-Zustand je Kanal: belegt bis busy_until, max. eine wartende Auslösung
+struct ActuatorChannel {
+  const char *name;
+  uint64_t busy_until;        // Kanal frei ab (absolute µs)
+  bool queued;                // Auslösung wartet auf das Ende der Belegung
+  uint32_t merged;            // Anfragen, die in eine wartende Auslösung zusammengefasst wurden
+};
+
+// Flanken laufen im Timer-Callback - dort keine Serial-Ausgabe (kann blockieren).
+// Der Fortschritt wird stattdessen aus timer_system_control_update() geloggt.
+#define EDGE_DEBUG_PRINTF(...)  do { if (!trigger_clock_in_callback()) DEBUG_PRINTF(__VA_ARGS__); } while (0)
+#define EDGE_DEBUG_PRINTLN(x)   do { if (!trigger_clock_in_callback()) DEBUG_PRINTLN(x); } while (0)
+
 // Timer States - ERWEITERT für Completion
 enum TimerExecutionMode {
   TIMER_EXEC_MODE,
   TLAPSE_EXEC_MODE,
-  INTERVAL_EXEC_MODE
+  INTERVAL_EXEC_MODE,
+  SEQUENCE_EXEC_MODE,    // Freies Programm (Serial "seq run" / BLE "SEQ:")
+  BURST_EXEC_MODE,       // Elektro-Burst: N Release-Impulse mit fester Rate
+  EXTERNAL_EXEC_MODE     // Externer Trigger: jede Flanke am Eingang löst aus
 };
 
 enum TimerExecutionState {
@@ -58,26 +104,57 @@ enum TimerExecutionState {
   INTERVAL_RUNNING,
   TIMER_COMPLETING,      // Vereinfacht - ein Completion-State für beide Systeme
   TLAPSE_COMPLETING,   
-  INTERVAL_COMPLETING
+  INTERVAL_COMPLETING,
+  SEQUENCE_RUNNING,
+  SEQUENCE_COMPLETING,
+  BURST_RUNNING,
+  BURST_COMPLETING,
+  EXTERNAL_ARMED         // Wartet auf Flanken - endet nur per Cancel
+};
+
+// Frame-Record: geplante vs. tatsächliche Auslösung
+enum FrameStatus {
+  FRAME_ON_TIME,    // Innerhalb der Toleranz ausgelöst
+  FRAME_LATE,       // Verspätet ausgelöst (FIRE_NOW / SHIFT)
+  FRAME_MISSED      // Nicht ausgelöst
+};
+
+struct FrameRecord {
+  uint32_t slot;            // Frame-Index im Plan (1-basiert)
+  uint64_t planned;         // Geplante Deadline in µs
+  uint64_t actual;          // Tatsächliche Auslösung (0 = nicht ausgelöst)
+  uint8_t status;           // FrameStatus
 };
 
 // Timer Runtime Data
 struct TimerRuntime {
   TimerExecutionMode mode;
   TimerExecutionState state;
-  unsigned long startTime;
-  unsigned long currentPhaseStartTime;
+  uint64_t startTime;             // µs (trigger_clock_now_us) - 64 Bit, kein Überlauf
+  uint64_t currentPhaseStartTime;
   int frameCount;
   int totalDelayTime;     // in seconds
-  int totalReleaseTime;   // in seconds
-  int totalTime;          // for T-Lapse in seconds
+  unsigned long totalReleaseMs;  // Bulb duration in ms (0 = TRIGGER)
+  int totalTime;          // for T-Lapse in seconds (bis VALUE_MAX_DURATION_S)
   int totalFrames;        // for T-Lapse
   int intervalTime;       // for Interval in seconds
-  float frameInterval;    // calculated interval between frames for T-Lapse
+  FramePlan tlapsePlan;   // Bresenham frame timestamps for T-Lapse (ms, display only)
+  SequenceVM sequenceVM;  // Position im kompilierten Programm
+  SequenceAction nextAction;  // Nächste Aktion (Programmzeit ab startTime)
+  bool holdActive;        // Bulb-Frame: Servo + Release gehalten bis RELEASE_END
+  int missedFrames;       // Not fired (CATCHUP_SKIP or overrun)
+  int lateFrames;         // Fired late (CATCHUP_FIRE_NOW / CATCHUP_SHIFT)
+  uint64_t scheduleShift;       // Accumulated shift of the remaining plan in µs (CATCHUP_SHIFT)
+  unsigned long shutterLag;     // Frames fire this much early (active camera profile, fixed per run)
+  int64_t syncMaster;           // Start in Masterzeit (µs), 0 = Lauf nicht synchronisiert
+  bool paused;                  // T-Lapse/Interval angehalten - keine neuen Frames
+  uint64_t pausedAt;            // µs, Beginn der laufenden Pause
+  uint64_t pausedTotal;         // Summe aller Pausen in µs
+  int pausedFrames;             // Frames, die auf dem alten Raster in eine Pause fielen (nicht verpasst)
   
   // Completion tracking - vereinfacht
   bool waiting_for_completion;
-  unsigned long completion_timeout;
+  uint64_t completion_timeout;  // µs
   bool logic_completed;   // Logic is done, but systems still active
 };
 
@@ -90,10 +167,36 @@ extern TimerRuntime runtime;
 extern int servoStartPosition;      
 extern int servoEndPosition;        // This becomes the "working stop position"
 extern int servoAbsoluteMaxPosition; // The true 100% reference point
-extern float servoActivationTime;
+extern uint32_t servo_activation_us;      // Haltezeit am Endanschlag (µs, aus Kanal 0)
 
 bool servo_is_activating = false;
-unsigned long servo_activation_start_time = 0;
+uint64_t servo_activation_start_time = 0;
+
+// Lauf wurde im Dispatch beendet - Seitenwechsel folgt in timer_system_update()
+volatile bool timer_ui_exit_pending = false;
+int timer_logged_frame_count = 0;
+int timer_logged_missed_count = 0;
+
+ActuatorChannel actuator_channels[ACTUATOR_COUNT] = {
+  {"servo", 0, false, 0},
+  {"elektro", 0, false, 0},
+  {"out2", 0, false, 0},
+  {"out3", 0, false, 0},
+  {"out4", 0, false, 0},
+  {"out5", 0, false, 0}
+};
+
+// Programm des laufenden Modus - beim Start einmal kompiliert
+SequenceProgram sequence_program;
+SequenceCode sequence_code;
+
+// Zuletzt gestartete/gesetzte Keyframe-Rampe (UI oder BLE/Serial)
+RampPlan tlapse_ramp = {{{0, 0}}, 0, RAMP_LINEAR};
+
+// Frame-Records des laufenden T-Lapse/Interval
+FrameRecord frame_log[FRAME_LOG_SIZE];
+uint8_t frame_log_head = 0;
+uint32_t frame_log_count = 0;
 
 // Elektro-Modus Variablen
 ElektroState elektro_state = {
@@ -105,9 +208,7 @@ ElektroState elektro_state = {
 };
 
 // Elektro-Modus Einstellungen (konfigurierbar)
-float elektro_focus_lead_time = 3.0;      // 1 Sekunde vor Release
-float elektro_focus_duration = 3.0;       // 1 Sekunde Fokus-Signal
-float elektro_release_duration = 0.6;     // 0.6 Sekunden Release für Trigger
+uint32_t elektro_release_us = 600000;     // 0,6 s Release für Trigger
 
 // UI Objects for Overlays
 extern lv_obj_t *timer_overlay;
@@ -118,12 +219,17 @@ extern lv_obj_t *timer_overlay_cancel_btn;
 extern lv_obj_t *tlapse_overlay;
 extern lv_obj_t *tlapse_overlay_time_label;
 extern lv_obj_t *tlapse_overlay_frame_counter;
+extern lv_obj_t *tlapse_overlay_missed_label;
 extern lv_obj_t *tlapse_overlay_cancel_btn;
+extern lv_obj_t *tlapse_overlay_pause_label;
 
 extern lv_obj_t *interval_overlay;
 extern lv_obj_t *interval_overlay_time_label;
 extern lv_obj_t *interval_overlay_frame_counter;
+extern lv_obj_t *interval_overlay_missed_label;
 extern lv_obj_t *interval_overlay_cancel_btn;
+extern lv_obj_t *interval_overlay_pause_btn;
+extern lv_obj_t *interval_overlay_pause_label;
 
 // =============================================================================
 // FUNCTION DECLARATIONS
@@ -132,58 +238,158 @@ extern lv_obj_t *interval_overlay_cancel_btn;
 // Bluetooth
 extern void send_ble_response(String response);
 
+// Time Sync (time_sync.h) - Deadlines synchronisierter Läufe
+bool time_sync_valid();
+uint64_t time_sync_master_to_local(int64_t master_us);
+
 // System Functions
 void timer_system_init();
-void timer_system_update();
+void timer_system_hardware_init();   // Ohne Overlays/Runtime-Reset (Deep-Sleep-Hot-Path)
+void timer_system_update();           // UI-Task: Overlays, Seitenwechsel, Lag-Messung
+void timer_system_control_update();   // Control-Task: Servo-Init, Fallback-Dispatch, Fortschritt
+const char* run_mode_name(TimerExecutionMode mode);
+
+// Fortschritt: der Control-Task meldet, der Housekeeping-Task gibt aus (tasks.h)
+enum ProgressLogType {
+  PROGRESS_FRAME,
+  PROGRESS_MISSED
+};
+extern bool housekeeping_log(uint8_t type, int32_t value);   // false = Task läuft nicht
+extern void low_power_wake_loop();                           // low_power.h
+extern void control_notify();                                // tasks.h
+void print_progress_log(uint8_t type, int32_t value);
 
 // Elektro-Modus Functions - VEREINFACHT
 void elektro_system_init();
-void elektro_system_update();
 void elektro_activate_focus();
-void elektro_activate_release();
+void elektro_extend_focus(uint64_t until);
+void elektro_deactivate_focus();
+void elektro_activate_release(uint64_t hold_us);
+void elektro_deactivate_release();
 void elektro_deactivate_all();
 bool is_elektro_active();
 
 // Servo Control Functions
 void servo_init();
 void servo_activate();
+void servo_return();
 void servo_move_to_position(int position);
 bool is_servo_active();
 
 // Combined Control Functions - NEU
-void activate_trigger();          // Aktiviert Servo UND Elektro synchron
-void activate_release_mode();     // Für Release-Modus
+void activate_trigger();                            // Aktiviert Servo UND Elektro synchron
+void activate_release_mode(unsigned long hold_ms);  // Für Release-Modus
 void deactivate_all_systems();   // Deaktiviert alles
 bool is_any_system_active();     // Prüft ob noch was aktiv ist
 
+// Actuator Pipeline
+void actuator_request(uint8_t channel);
+void actuator_fire(uint8_t channel, uint64_t now);
+void on_actuator_ready();
+void actuator_pipeline_reset();
+bool actuator_pending();
+unsigned long actuator_busy_ms(uint8_t channel);
+unsigned long trigger_min_frame_interval_ms();
+uint32_t tlapse_max_frames(uint32_t total_seconds);
+String actuator_rates_string();
+
+// Scheduler Dispatch
+void trigger_clock_dispatch();   // Callback der One-Shot-Uhr
+void dispatch_scheduled_events();
+void handle_scheduled_event(const ScheduledEvent &event);
+void schedule_focus_before(uint64_t release_at, unsigned long lead_ms);
+uint32_t frame_focus_lead_ms();  // Fokus-Vorlauf für T-Lapse/Interval-Frames (0 = aus)
+void set_focus_config(bool every_frame, int lead_ms, int duration_ms);
+void end_execution_run();        // Callback-sicher, ohne UI-Aufrufe
+
 // Timer Execution Functions
 void start_timer_execution();
 void start_tlapse_execution();
 void start_interval_execution();
+void start_burst_execution();
+void launch_timer_execution(int delaySeconds, uint32_t releaseMs);
+bool launch_tlapse_execution(int totalSeconds, int frames);     // false = Rate nicht machbar
+bool launch_tlapse_ramp(const RampPlan &plan);                  // false = Plan/Rate ungültig
+bool tlapse_ramp_from_options(uint32_t total_s, uint32_t frames, uint32_t end_s, uint8_t curve, RampPlan &plan);
+void set_ramp_curve(int curve);
+void print_ramp_plan(const RampPlan &plan);
+bool launch_interval_execution(int intervalSeconds);            // false = Rate nicht machbar
+bool launch_sequence_execution(String text);                    // false = Syntax/Rate ungültig
+bool launch_burst_execution(int count, int rate_hz, int pulse_ms);  // false = Parameter ungültig
+bool burst_config_valid(int count, int rate_hz, int pulse_ms);
+uint32_t burst_max_pulse_ms(int rate_hz);   // Längster Impuls, der mit BURST_MIN_GAP_MS in die Periode passt
+void set_burst_config(int count, int rate_hz, int pulse_ms);
+bool launch_sequence(const SequenceProgram &program, TimerExecutionMode mode, TimerExecutionState state);
+void begin_run_state(TimerExecutionMode mode, TimerExecutionState state);   // Aufrufer hält trigger_clock_lock
 void cancel_timer_execution();
-
-// Timer Update Functions
-void update_timer_execution();
-void update_tlapse_execution();
-void update_interval_execution();
+void finish_execution_logic();
+bool timer_run_armed();          // Lauf geplant, Startzeit noch nicht erreicht
+bool start_execution_at(uint64_t start_us, TimerExecutionMode mode);   // Seitenwerte, Start zur Trigger-Zeit
+
+// Pause/Resume (T-Lapse, Interval, Sequence)
+bool run_pausable();
+bool pause_execution();
+bool resume_execution(bool shift);  // shift: Rest um die Pause verschieben, sonst altes Raster
+void skip_paused_frames(uint64_t now);
+void set_resume_shift(bool shift);
+
+// Sequence Executor - wird vom Scheduler zur Deadline aufgerufen
+void on_sequence_event();
+void schedule_sequence_action();
+void execute_sequence_frame(const SequenceAction &action, uint64_t now);
+uint64_t sequence_action_deadline(const SequenceAction &action);
+unsigned long completion_grace_ms();
+
+// Shutter-Lag Messung (Release -> X-Sync-Flanke)
+bool lag_measure_start();
+void lag_measure_update();
+void lag_sense_isr();
+
+// External trigger
+bool launch_external_trigger();
+void ext_trigger_disarm();
+bool ext_trigger_accept(uint64_t edge_us);   // ISR-sicher
+void ext_trigger_isr();
+void ext_trigger_service();                  // Verzögerung, Auslösung und Buchführung (Task-Kontext)
+void ext_trigger_complete();
+bool ext_trigger_simulate();
+bool ext_trigger_config_valid(int delay_ms, int lockout_ms);
+void set_ext_trigger_config(int delay_ms, int lockout_ms, bool servo);
+String ext_trigger_status_string();
+void print_ext_trigger_status();
+
+// Missed-Frame Handling
+bool frame_should_fire(uint32_t slot, uint64_t planned, uint64_t now, bool allow_late = true);
+void record_frame(uint32_t slot, uint64_t planned, uint64_t actual, uint8_t status);
+void record_missed_frame(uint32_t slot, uint64_t planned);
+void reset_frame_log();
+void set_catchup_policy(int policy);
+const char* catchup_policy_name(int policy);
 
 // Overlay Management Functions
 void create_timer_overlays();
+void show_run_overlay();           // Overlay passend zu runtime.mode
 void show_timer_overlay();
 void show_tlapse_overlay();
 void show_interval_overlay();
 void hide_timer_overlays();
+void update_armed_overlay(lv_obj_t *time_label, lv_obj_t *info_label);
 void update_timer_overlay_display();
 void update_tlapse_overlay_display();
 void update_interval_overlay_display();
 
 // Utility Functions
 String format_countdown_time(int totalSeconds, int elapsedSeconds, bool showBoth = false);
+void print_tlapse_plan(int frame = 0);
+void print_frame_log();
+void print_actuator_status();
+void handle_timer_serial_commands(String command);
 
 // Event Callbacks
 void timer_cancel_cb(lv_event_t *e);
 void tlapse_cancel_cb(lv_event_t *e);
 void interval_cancel_cb(lv_event_t *e);
+void run_pause_cb(lv_event_t *e);
 
 // =============================================================================
 // IMPLEMENTATION
@@ -197,7 +403,7 @@ TimerRuntime runtime;
 int servoStartPosition = 0;      
 int servoEndPosition = 90;       // Working stop position
 int servoAbsoluteMaxPosition = SERVO_ABSOLUTE_MAX_POSITION; // True 100% reference
-float servoActivationTime = 0.6;
+uint32_t servo_activation_us = MS_TO_US(SERVO_ACTIVATION_MS);
 
 // UI Objects Implementation
 lv_obj_t *timer_overlay = nullptr;
@@ -208,12 +414,17 @@ lv_obj_t *timer_overlay_cancel_btn = nullptr;
 lv_obj_t *tlapse_overlay = nullptr;
 lv_obj_t *tlapse_overlay_time_label = nullptr;
 lv_obj_t *tlapse_overlay_frame_counter = nullptr;
+lv_obj_t *tlapse_overlay_missed_label = nullptr;
 lv_obj_t *tlapse_overlay_cancel_btn = nullptr;
+lv_obj_t *tlapse_overlay_pause_label = nullptr;
 
 lv_obj_t *interval_overlay = nullptr;
 lv_obj_t *interval_overlay_time_label = nullptr;
 lv_obj_t *interval_overlay_frame_counter = nullptr;
+lv_obj_t *interval_overlay_missed_label = nullptr;
 lv_obj_t *interval_overlay_cancel_btn = nullptr;
+lv_obj_t *interval_overlay_pause_btn = nullptr;
+lv_obj_t *interval_overlay_pause_label = nullptr;
 
 // =============================================================================
 // ELEKTRO-MODUS IMPLEMENTATION - VEREINFACHT
@@ -233,26 +444,65 @@ void elektro_system_init() {
   elektro_state.focus_active = false;
   elektro_state.release_active = false;
   elektro_state.focus_start_time = 0;
+  elektro_state.focus_end_time = 0;
   elektro_state.release_start_time = 0;
-  elektro_state.focus_scheduled_time = 0;
   
   DEBUG_PRINTLN("Elektro system initialized");
 }
 
 void elektro_activate_focus() {
+  uint64_t now = trigger_clock_now_us();
+  
+  if (elektro_state.focus_active) {
+    // Läuft schon (überlappende Fenster) - nur das Ende nach hinten schieben
+    elektro_extend_focus(now + MS_TO_US(app_state.focus_duration_ms));
+    return;
+  }
+  
   digitalWrite(ELEKTRO_FOCUS_PIN, HIGH);
+  outputs_extra_focus(true);
   elektro_state.focus_active = true;
-  elektro_state.focus_start_time = millis();
+  elektro_state.focus_start_time = now;
+  elektro_state.focus_end_time = now + MS_TO_US(app_state.focus_duration_ms);
   
-  DEBUG_PRINTF("Elektro: Focus activated for %.1fs\n", elektro_focus_duration);
+  // Fokus-Ende als absolute Deadline einplanen
+  scheduler_remove(EVENT_FOCUS_END);
+  scheduler_push(EVENT_FOCUS_END, elektro_state.focus_end_time);
+  
+  EDGE_DEBUG_PRINTF("Elektro: Focus activated for %dms\n", app_state.focus_duration_ms);
+}
+
+void elektro_extend_focus(uint64_t until) {
+  if (!elektro_state.focus_active || time_reached(elektro_state.focus_end_time, until)) return;
+  
+  elektro_state.focus_end_time = until;
+  scheduler_remove(EVENT_FOCUS_END);
+  scheduler_push(EVENT_FOCUS_END, until);
+  
+  EDGE_DEBUG_PRINTF("Elektro: Focus extended by overlapping window\n");
+}
+
+void elektro_deactivate_focus() {
+  digitalWrite(ELEKTRO_FOCUS_PIN, LOW);
+  outputs_extra_focus(false);
+  elektro_state.focus_active = false;
+  EDGE_DEBUG_PRINTLN("Elektro: Focus deactivated (timeout)");
 }
 
-void elektro_activate_release() {
+void elektro_activate_release(uint64_t hold_us) {
   digitalWrite(ELEKTRO_RELEASE_PIN, HIGH);
   elektro_state.release_active = true;
-  elektro_state.release_start_time = millis();
+  elektro_state.release_start_time = trigger_clock_now_us();
+  
+  scheduler_push(EVENT_RELEASE_END, elektro_state.release_start_time + hold_us);
   
-  DEBUG_PRINTF("Elektro: Release activated for %.1fs\n", elektro_release_duration);
+  EDGE_DEBUG_PRINTF("Elektro: Release activated for %lums\n", (unsigned long)US_TO_MS(hold_us));
+}
+
+void elektro_deactivate_release() {
+  digitalWrite(ELEKTRO_RELEASE_PIN, LOW);
+  elektro_state.release_active = false;
+  EDGE_DEBUG_PRINTLN("Elektro: Release deactivated (timeout)");
 }
 
 void elektro_deactivate_all() {
@@ -261,39 +511,7 @@ void elektro_deactivate_all() {
   elektro_state.focus_active = false;
   elektro_state.release_active = false;
   
-  DEBUG_PRINTLN("Elektro: All signals deactivated");
-}
-
-void elektro_system_update() {
-  unsigned long current_time = millis();
-  
-  // Update focus signal
-  if (elektro_state.focus_active) {
-    unsigned long focus_elapsed = current_time - elektro_state.focus_start_time;
-    if (focus_elapsed >= (elektro_focus_duration * 1000)) {
-      digitalWrite(ELEKTRO_FOCUS_PIN, LOW);
-      elektro_state.focus_active = false;
-      DEBUG_PRINTLN("Elektro: Focus deactivated (timeout)");
-    }
-  }
-  
-  // Update release signal
-  if (elektro_state.release_active) {
-    unsigned long release_elapsed = current_time - elektro_state.release_start_time;
-    if (release_elapsed >= (elektro_release_duration * 1000)) {
-      digitalWrite(ELEKTRO_RELEASE_PIN, LOW);
-      elektro_state.release_active = false;
-      DEBUG_PRINTLN("Elektro: Release deactivated (timeout)");
-    }
-  }
-  
-  // Check for scheduled focus activation
-  if (elektro_state.focus_scheduled_time > 0 && 
-      current_time >= elektro_state.focus_scheduled_time && 
-      !elektro_state.focus_active) {
-    elektro_activate_focus();
-    elektro_state.focus_scheduled_time = 0;
-  }
+  EDGE_DEBUG_PRINTLN("Elektro: All signals deactivated");
 }
 
 bool is_elektro_active() {
@@ -323,28 +541,24 @@ void servo_init() {
 void servo_move_to_position(int position) {
   position = constrain(position, 0, 180);
   cameraServo.write(position);
-  DEBUG_PRINTF("Servo moved to %d°\n", position);
+  EDGE_DEBUG_PRINTF("Servo moved to %d°\n", position);
 }
 
 void servo_activate() {
   if (!servo_is_activating) {
     servo_is_activating = true;
-    servo_activation_start_time = millis();
+    servo_activation_start_time = trigger_clock_now_us();
     servo_move_to_position(servoEndPosition);
-    DEBUG_PRINTF("Servo activation started: %d° -> %d° for %.1fs\n", 
-                 servoStartPosition, servoEndPosition, servoActivationTime);
+    scheduler_push(EVENT_SERVO_RETURN, servo_activation_start_time + servo_activation_us);
+    EDGE_DEBUG_PRINTF("Servo activation started: %d° -> %d° for %lums\n", 
+                 servoStartPosition, servoEndPosition, (unsigned long)US_TO_MS(servo_activation_us));
   }
 }
 
-void servo_update() {
-  if (servo_is_activating) {
-    unsigned long elapsed = millis() - servo_activation_start_time;
-    if (elapsed >= (servoActivationTime * 1000)) {
-      servo_move_to_position(servoStartPosition);
-      servo_is_activating = false;
-      DEBUG_PRINTLN("Servo activation complete - returned to start position");
-    }
-  }
+void servo_return() {
+  servo_move_to_position(servoStartPosition);
+  servo_is_activating = false;
+  EDGE_DEBUG_PRINTLN("Servo activation complete - returned to start position");
 }
 
 bool is_servo_active() {
@@ -356,45 +570,332 @@ bool is_servo_active() {
 // =============================================================================
 
 void activate_trigger() {
-  // Aktiviert BEIDE Systeme synchron für Trigger-Modus
-  servo_activate();
-  elektro_activate_release();
+  // Fächert auf alle aktiven Kanäle auf - belegte Kanäle lösen aus, sobald sie frei sind.
+  // Versätze zählen ab derselben Basis, damit sich Ungenauigkeiten nicht aufaddieren.
+  uint64_t now = trigger_clock_now_us();
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    if (!output_enabled(i)) continue;
+    if (output_offset_ms(i) == 0) {
+      actuator_request(i);
+    } else {
+      scheduler_push(EVENT_CHANNEL_FIRE, now + MS_TO_US(output_offset_ms(i)), i);
+    }
+  }
   
-  DEBUG_PRINTLN("COMBINED: Trigger activated (Servo + Elektro)");
+  EDGE_DEBUG_PRINTLN("COMBINED: Trigger activated on all output channels");
 }
 
-void activate_release_mode() {
-  // Für Release-Modus: Servo auf Position + Elektro Release
-  servo_move_to_position(servoEndPosition);
-  elektro_activate_release();
+void activate_release_mode(unsigned long hold_ms) {
+  // Für Release-Modus: alle Kanäle halten bis zum Bulb-Ende (ohne Versatz)
+  if (output_enabled(ACTUATOR_SERVO)) servo_move_to_position(servoEndPosition);
+  if (output_enabled(ACTUATOR_ELEKTRO)) {
+    elektro_activate_release(MS_TO_US(hold_ms));
+  } else {
+    scheduler_push(EVENT_RELEASE_END, trigger_clock_now_us() + MS_TO_US(hold_ms));
+  }
+  outputs_extra_drive(true);
   
-  DEBUG_PRINTLN("COMBINED: Release mode activated (Servo + Elektro)");
+  EDGE_DEBUG_PRINTLN("COMBINED: Release mode activated on all output channels");
 }
 
 void deactivate_all_systems() {
-  // Deaktiviert BEIDE Systeme
+  // Deaktiviert alle Kanäle
   servo_move_to_position(servoStartPosition);
+  servo_is_activating = false;
   elektro_deactivate_all();
+  outputs_extra_off();
+  actuator_pipeline_reset();
   
-  DEBUG_PRINTLN("COMBINED: All systems deactivated");
+  EDGE_DEBUG_PRINTLN("COMBINED: All systems deactivated");
 }
 
 bool is_any_system_active() {
-  return is_servo_active() || is_elektro_active();
+  return is_servo_active() || is_elektro_active() || outputs_extra_active() || actuator_pending();
 }
 
 // =============================================================================
-// TIMER SYSTEM FUNCTIONS - VEREINFACHT
+// ACTUATOR PIPELINE - Belegtzeiten je Kanal, wartende Auslösungen
 // =============================================================================
-void timer_system_init() {
-  DEBUG_PRINTLN("Initializing timer system...");
+unsigned long actuator_busy_ms(uint8_t channel) {
+  if (!output_enabled(channel)) return 0;
+  return output_width_ms(channel) + (output_is_servo(channel) ? SERVO_RETURN_TIME_MS : ELEKTRO_RELEASE_GAP_MS);
+}
+
+unsigned long trigger_min_frame_interval_ms() {
+  // Jeder Frame nutzt alle aktiven Kanäle - der langsamste bestimmt die Rate
+  unsigned long slowest = 0;
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    slowest = max(slowest, actuator_busy_ms(i));
+  }
+  return slowest;
+}
+
+uint32_t tlapse_max_frames(uint32_t total_seconds) {
+  unsigned long min_interval = trigger_min_frame_interval_ms();
+  if (min_interval == 0) return total_seconds;
+  return (uint32_t)(((uint64_t)total_seconds * 1000) / min_interval);
+}
+
+void actuator_request(uint8_t channel) {
+  ActuatorChannel &ch = actuator_channels[channel];
+  uint64_t now = trigger_clock_now_us();
+  
+  if (!ch.queued && time_reached(now, ch.busy_until)) {
+    actuator_fire(channel, now);
+    return;
+  }
+  
+  if (ch.queued) {
+    // Es wartet schon eine Auslösung - zusammenfassen statt stapeln
+    ch.merged++;
+    EDGE_DEBUG_PRINTF("Actuator %s busy - request merged\n", ch.name);
+    return;
+  }
+  
+  ch.queued = true;
+  scheduler_push(EVENT_ACTUATOR_READY, ch.busy_until);
+  EDGE_DEBUG_PRINTF("Actuator %s busy - queued for %lums\n", ch.name, (unsigned long)US_TO_MS(ch.busy_until - now));
+}
+
+void actuator_fire(uint8_t channel, uint64_t now) {
+  actuator_channels[channel].busy_until = now + MS_TO_US(actuator_busy_ms(channel));
+  
+  switch (channel) {
+    case ACTUATOR_SERVO:
+      servo_activate();
+      break;
+    case ACTUATOR_ELEKTRO:
+      elektro_activate_release(elektro_release_us);
+      break;
+    default:
+      output_drive(channel, true);
+      scheduler_push(EVENT_CHANNEL_END, now + MS_TO_US(output_width_ms(channel)), channel);
+      break;
+  }
+}
+
+void on_actuator_ready() {
+  uint64_t now = trigger_clock_now_us();
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    ActuatorChannel &ch = actuator_channels[i];
+    if (ch.queued && time_reached(now, ch.busy_until)) {
+      ch.queued = false;
+      actuator_fire(i, now);
+    }
+  }
+}
+
+void actuator_pipeline_reset() {
+  // Wartende Auslösungen verwerfen - ihre Scheduler-Events sind ebenfalls weg
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    actuator_channels[i].queued = false;
+  }
+}
+
+bool actuator_pending() {
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    if (actuator_channels[i].queued) return true;
+  }
+  return false;
+}
+
+String actuator_rates_string() {
+  // Format: SERVO:1.11,ELEKTRO:1.43 (Frames pro Sekunde)
+  String rates = "";
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    if (!output_enabled(i)) continue;
+    unsigned long busy = actuator_busy_ms(i);
+    if (rates.length() > 0) rates += ",";
+    String name = actuator_channels[i].name;
+    name.toUpperCase();
+    rates += name + ":" + String(busy > 0 ? 1000.0f / busy : 0.0f, 2);
+  }
+  return rates;
+}
+
+// =============================================================================
+// SCHEDULER DISPATCH
+// =============================================================================
+void trigger_clock_dispatch() {
+  // Läuft im esp_timer-Task: nur Flanken + Planung, keine UI-Aufrufe
+  trigger_clock_lock();
+  int frames = runtime.frameCount;
+  int missed = runtime.missedFrames;
+  TimerExecutionState state = runtime.state;
+  dispatch_scheduled_events();
+  bool changed = frames != runtime.frameCount || missed != runtime.missedFrames || state != runtime.state;
+  trigger_clock_unlock();
+  
+  // Control-Task schläft ohne Timeout - nur bei neuem Frame/Zustand wecken
+  if (changed) control_notify();
+}
+
+void dispatch_scheduled_events() {
+  uint64_t now = trigger_clock_now_us();
+  ScheduledEvent event;
+  
+  // Begrenzen, damit sofort fällige Folge-Events den Dispatch nicht blockieren
+  for (int i = 0; i < SCHEDULER_QUEUE_SIZE; i++) {
+    if (!scheduler_pop_due(now, event)) break;
+    handle_scheduled_event(event);
+    
+    // Completion-Phase endet, sobald Servo und Elektro fertig sind
+    if ((runtime.state == TIMER_COMPLETING || 
+         runtime.state == TLAPSE_COMPLETING || 
+         runtime.state == INTERVAL_COMPLETING ||
+         runtime.state == SEQUENCE_COMPLETING ||
+         runtime.state == BURST_COMPLETING) && !is_any_system_active()) {
+      EDGE_DEBUG_PRINTLN("Completion phase finished");
+      end_execution_run();
+    }
+    if (runtime.state == TIMER_IDLE && scheduler_count() == 0) break;
+  }
+  
+  // Uhr auf den neuen Queue-Kopf stellen
+  scheduler_rearm();
+}
+
+void handle_scheduled_event(const ScheduledEvent &event) {
+  switch (event.type) {
+    case EVENT_FOCUS_START:
+      elektro_activate_focus();
+      break;
+      
+    case EVENT_FOCUS_END:
+      elektro_deactivate_focus();
+      break;
+      
+    case EVENT_RELEASE_START:
+      // Alle Modi laufen als Programm - nächste Aktion abarbeiten
+      on_sequence_event();
+      break;
+      
+    case EVENT_RELEASE_END:
+      if (runtime.holdActive) {
+        // Bulb-Ende: Servo zurück + Release aus. Das Programmende folgt über SEQ_OP_END
+        runtime.holdActive = false;
+        servo_move_to_position(servoStartPosition);
+        elektro_deactivate_release();
+        outputs_extra_drive(false);
+        EDGE_DEBUG_PRINTLN("Bulb frame complete - servo and release off");
+      } else {
+        elektro_deactivate_release();
+      }
+      break;
+      
+    case EVENT_SERVO_RETURN:
+      servo_return();
+      break;
+      
+    case EVENT_ACTUATOR_READY:
+      on_actuator_ready();
+      break;
+      
+    case EVENT_CHANNEL_FIRE:
+      actuator_request(event.channel);
+      break;
+      
+    case EVENT_CHANNEL_END:
+      output_drive(event.channel, false);
+      break;
+      
+    case EVENT_COMPLETE:
+      if (runtime.state == TIMER_COMPLETING || 
+          runtime.state == TLAPSE_COMPLETING || 
+          runtime.state == INTERVAL_COMPLETING ||
+          runtime.state == SEQUENCE_COMPLETING ||
+          runtime.state == BURST_COMPLETING) {
+        EDGE_DEBUG_PRINTLN("Completion timeout reached");
+        end_execution_run();
+      } else if (runtime.state != TIMER_IDLE && !runtime.logic_completed) {
+        finish_execution_logic();
+      }
+      break;
+  }
+}
+
+void schedule_focus_before(uint64_t release_at, unsigned long lead_ms) {
+  // Fokus-Vorlauf relativ zur absoluten Release-Deadline
+  uint64_t lead_us = MS_TO_US(lead_ms);
+  uint64_t focus_at = release_at > lead_us ? release_at - lead_us : 0;
+  
+  scheduler_remove(EVENT_FOCUS_START);
+  
+  // Fenster überlappt das laufende (oder die Lücke ist zu kurz) - Signal durchgehend halten
+  if (elektro_state.focus_active && 
+      !time_reached(focus_at, elektro_state.focus_end_time + MS_TO_US(FOCUS_MERGE_GAP_MS))) {
+    elektro_extend_focus(focus_at + MS_TO_US(app_state.focus_duration_ms));
+    return;
+  }
+  
+  uint64_t now = trigger_clock_now_us();
+  if (time_reached(now, focus_at)) {
+    elektro_activate_focus();
+    EDGE_DEBUG_PRINTF("Elektro: Focus activated immediately (lead time %lums)\n", lead_ms);
+  } else {
+    scheduler_push(EVENT_FOCUS_START, focus_at);
+    EDGE_DEBUG_PRINTF("Elektro: Focus scheduled in %lums\n", (unsigned long)US_TO_MS(focus_at - now));
+  }
+}
+
+uint32_t frame_focus_lead_ms() {
+  if (!app_state.frame_focus || app_state.focus_duration_ms <= 0) return 0;
+  return (uint32_t)app_state.focus_lead_ms;
+}
+
+void set_focus_config(bool every_frame, int lead_ms, int duration_ms) {
+  if (lead_ms < 0 || lead_ms > FOCUS_MAX_MS || duration_ms < 0 || duration_ms > FOCUS_MAX_MS) return;
+  app_state.frame_focus = every_frame;
+  app_state.focus_lead_ms = lead_ms;
+  app_state.focus_duration_ms = duration_ms;
+  save_app_state();
+  DEBUG_PRINTF("Focus: lead %d ms, duration %d ms, every frame %s\n", 
+               lead_ms, duration_ms, every_frame ? "ON" : "OFF");
+}
+
+void end_execution_run() {
+  runtime.state = TIMER_IDLE;
+  runtime.waiting_for_completion = false;
+  runtime.logic_completed = false;
+  
+  scheduler_clear();
+  deactivate_all_systems();
   
+  // Overlays schließen und Seite wechseln darf nur die Loop
+  timer_ui_exit_pending = true;
+}
+
+// =============================================================================
+// TIMER SYSTEM FUNCTIONS - VEREINFACHT
+// =============================================================================
+void timer_system_hardware_init() {
+  // Uhr, Scheduler und Ausgänge - im Deep-Sleep-Hot-Path ohne UI
+  trigger_clock_init(trigger_clock_dispatch);
+  scheduler_init();
   servo_init();
   elektro_system_init();
+  outputs_init();
+  lag_profiles_init();
   
   // Initialize servo tracking
   servo_initialization_complete = false;
   servo_init_start_time = 0;
+  timer_hardware_ready = true;
+}
+
+void timer_system_init() {
+  DEBUG_PRINTLN("Initializing timer system...");
+  
+  if (!timer_hardware_ready) {
+    timer_system_hardware_init();
+  }
+  
+  // Nach Deep-Sleep ist runtime bereits aus dem RTC-Speicher wiederhergestellt
+  if (timer_run_resumed) {
+    create_timer_overlays();
+    DEBUG_PRINTLN("Timer system initialized - resumed run kept");
+    return;
+  }
   
   // Initialize runtime data
   runtime.mode = TIMER_EXEC_MODE;
@@ -403,11 +904,24 @@ void timer_system_init() {
   runtime.currentPhaseStartTime = 0;
   runtime.frameCount = 0;
   runtime.totalDelayTime = 0;
-  runtime.totalReleaseTime = 0;
+  runtime.totalReleaseMs = 0;
   runtime.totalTime = 0;
   runtime.totalFrames = 0;
   runtime.intervalTime = 0;
-  runtime.frameInterval = 0.0;
+  frame_plan_init(runtime.tlapsePlan, 0, 0);
+  sequence_reset(runtime.sequenceVM);
+  runtime.nextAction.type = SEQ_ACTION_END;
+  runtime.holdActive = false;
+  runtime.missedFrames = 0;
+  runtime.lateFrames = 0;
+  runtime.scheduleShift = 0;
+  runtime.shutterLag = 0;
+  runtime.syncMaster = 0;
+  runtime.paused = false;
+  runtime.pausedAt = 0;
+  runtime.pausedTotal = 0;
+  runtime.pausedFrames = 0;
+  reset_frame_log();
   
   // Completion tracking - vereinfacht
   runtime.waiting_for_completion = false;
@@ -419,7 +933,7 @@ void timer_system_init() {
   DEBUG_PRINTLN("Timer system initialized successfully!");
 }
 
-void timer_system_update() {
+void timer_system_control_update() {
   // Handle servo initialization (non-blocking)
   if (!servo_initialization_complete) {
     if (servo_init_start_time == 0) {
@@ -435,53 +949,84 @@ void timer_system_update() {
     return;
   }
   
-  // Update both systems
-  elektro_system_update();
-  servo_update();
-  
-  if (runtime.state == TIMER_IDLE) return;
+  // Flanken feuert die One-Shot-Uhr. Hier nur Fallback, falls der Timer fehlt
+  trigger_clock_lock();
+  dispatch_scheduled_events();
+  int frames = runtime.frameCount;
+  int missed = runtime.missedFrames;
+  TimerExecutionState state = runtime.state;
+  trigger_clock_unlock();
+  
+  // Neuer Frame oder Zustandswechsel -> UI wartet nicht bis zum nächsten LVGL-Timer
+  static TimerExecutionState notified_state = TIMER_IDLE;
+  if (frames != timer_logged_frame_count || missed != timer_logged_missed_count || state != notified_state) {
+    notified_state = state;
+    low_power_wake_loop();
+  }
   
-  // Handle completion states - VEREINFACHT
-  if (runtime.state == TIMER_COMPLETING || 
-      runtime.state == TLAPSE_COMPLETING || 
-      runtime.state == INTERVAL_COMPLETING) {
-    
-    // Check if all systems are done OR timeout reached
-    if (!is_any_system_active() || millis() > runtime.completion_timeout) {
-      DEBUG_PRINTLN("Completion phase finished");
-      runtime.state = TIMER_IDLE;
-      runtime.waiting_for_completion = false;
-      runtime.logic_completed = false;
-      hide_timer_overlays();
-      show_current_page();
-      return;
+  // Fortschritt aus dem Callback nachträglich loggen - Ausgabe im Housekeeping-Task
+  if (frames != timer_logged_frame_count) {
+    if (frames > 0 && !housekeeping_log(PROGRESS_FRAME, frames)) {
+      print_progress_log(PROGRESS_FRAME, frames);
     }
-    
-    // Continue updating display during completion
-    switch (runtime.mode) {
-      case TIMER_EXEC_MODE:
-        update_timer_overlay_display();
-        break;
-      case TLAPSE_EXEC_MODE:
-        update_tlapse_overlay_display();
-        break;
-      case INTERVAL_EXEC_MODE:
-        update_interval_overlay_display();
-        break;
+    timer_logged_frame_count = frames;
+  }
+  if (missed != timer_logged_missed_count) {
+    if (missed > 0 && !housekeeping_log(PROGRESS_MISSED, missed)) {
+      print_progress_log(PROGRESS_MISSED, missed);
     }
+    timer_logged_missed_count = missed;
+  }
+}
+
+const char* run_mode_name(TimerExecutionMode mode) {
+  switch (mode) {
+    case TLAPSE_EXEC_MODE:   return "T-Lapse";
+    case INTERVAL_EXEC_MODE: return "Interval";
+    case SEQUENCE_EXEC_MODE: return "Sequence";
+    case BURST_EXEC_MODE:    return "Burst";
+    case EXTERNAL_EXEC_MODE: return "External";
+    default:                 return "Timer";
+  }
+}
+
+void print_progress_log(uint8_t type, int32_t value) {
+  if (type == PROGRESS_FRAME) {
+    DEBUG_PRINTF("Frame %ld triggered (%s)\n", (long)value, run_mode_name(runtime.mode));
+  } else {
+    DEBUG_PRINTF("WARNING: %ld frame(s) missed so far\n", (long)value);
+  }
+}
+
+void timer_system_update() {
+  // Control-Teil läuft im eigenen Task (tasks.h) - hier nur, was LVGL anfasst
+  if (!servo_initialization_complete) return;
+  
+  lag_measure_update();
+  
+  if (timer_ui_exit_pending) {
+    timer_ui_exit_pending = false;
+    DEBUG_PRINTLN("Timer execution finished");
+    hide_timer_overlays();
+    show_current_page();
     return;
   }
   
-  // Normal execution states
+  if (runtime.state == TIMER_IDLE) return;
+  
+  // Anzeige aktualisieren - die Logik läuft komplett über den Scheduler
   switch (runtime.mode) {
     case TIMER_EXEC_MODE:
-      update_timer_execution();
+      update_timer_overlay_display();
       break;
     case TLAPSE_EXEC_MODE:
-      update_tlapse_execution();
+      update_tlapse_overlay_display();
       break;
     case INTERVAL_EXEC_MODE:
-      update_interval_execution();
+    case SEQUENCE_EXEC_MODE:
+    case BURST_EXEC_MODE:
+    case EXTERNAL_EXEC_MODE:
+      update_interval_overlay_display();
       break;
   }
 }
@@ -490,221 +1035,1034 @@ void timer_system_update() {
 // TIMER EXECUTION FUNCTIONS
 // =============================================================================
 void start_timer_execution() {
+  DEBUG_PRINTLN("Starting Timer execution...");
+  
+  int delaySeconds = get_option_value(STATE_TIMER, 0);    
+  uint32_t releaseValue = get_option_value(STATE_TIMER, 1);   // ms
+  
+  bool isTriggerMode = (releaseValue == 4294967295 || (int32_t)releaseValue == -1);
+  
+  launch_timer_execution(delaySeconds, isTriggerMode ? 0 : releaseValue);
+}
+
+void launch_timer_execution(int delaySeconds, uint32_t releaseMs) {
   if (!servo_initialization_complete) {
     DEBUG_PRINTLN("Timer start blocked - servo still initializing");
     return;
   }
-
-  DEBUG_PRINTLN("Starting Timer execution...");
-  
-  runtime.totalDelayTime = get_option_value(STATE_TIMER, 0);    
-  uint32_t releaseValue = get_option_value(STATE_TIMER, 1);     
   
-  bool isTriggerMode = (releaseValue == 4294967295 || (int32_t)releaseValue == -1);
+  runtime.totalDelayTime = delaySeconds;
+  runtime.totalReleaseMs = releaseMs;   // 0 = TRIGGER mode
   
-  if (isTriggerMode) {
-    runtime.totalReleaseTime = 0; 
+  if (runtime.totalReleaseMs == 0) {
     DEBUG_PRINTLN("Timer in TRIGGER mode - single activation after delay");
-  } else {
-    runtime.totalReleaseTime = releaseValue;
   }
   
-  runtime.mode = TIMER_EXEC_MODE;
-  runtime.state = TIMER_DELAY_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
-  
-  // Reset elektro state
-  elektro_state.focus_scheduled_time = 0;
-  elektro_deactivate_all();
+  // Delay, ein Frame (Trigger oder Bulb) mit Fokus-Vorlauf
+  sequence_preset_timer(sequence_program, (uint32_t)runtime.totalDelayTime * 1000, 
+                        runtime.totalReleaseMs, 
+                        (uint32_t)app_state.focus_lead_ms);
+  if (!launch_sequence(sequence_program, TIMER_EXEC_MODE, TIMER_DELAY_RUNNING)) return;
   
-  servo_move_to_position(servoStartPosition);
   show_timer_overlay();
   
-  if (isTriggerMode) {
+  if (runtime.totalReleaseMs == 0) {
     DEBUG_PRINTF("Timer started: Delay %ds, Mode: TRIGGER (Combined Servo+Elektro)\n", runtime.totalDelayTime);
   } else {
-    DEBUG_PRINTF("Timer started: Delay %ds, Release %ds (Combined Servo+Elektro)\n", 
-                 runtime.totalDelayTime, runtime.totalReleaseTime);
+    DEBUG_PRINTF("Timer started: Delay %ds, Release %lums (Combined Servo+Elektro)\n", 
+                 runtime.totalDelayTime, runtime.totalReleaseMs);
   }
 }
 
 void start_tlapse_execution() {
   DEBUG_PRINTLN("Starting T-Lapse execution...");
   
-  runtime.totalTime = get_option_value(STATE_TLAPSE, 0);    
-  runtime.totalFrames = get_option_value(STATE_TLAPSE, 1);  
+  uint32_t ramp_end_s = get_option_value(STATE_TLAPSE, 2);
+  if (ramp_end_s == 0) {
+    launch_tlapse_execution(get_option_value(STATE_TLAPSE, 0), get_option_value(STATE_TLAPSE, 1));
+    return;
+  }
+  
+  // Ramp-Karte gesetzt: gleiche Frames über gleiche Dauer, Abstand läuft auf den Endwert zu
+  RampPlan plan;
+  if (tlapse_ramp_from_options(get_option_value(STATE_TLAPSE, 0), get_option_value(STATE_TLAPSE, 1), 
+                               ramp_end_s, app_state.ramp_curve, plan)) {
+    launch_tlapse_ramp(plan);
+  }
+}
+
+bool tlapse_ramp_from_options(uint32_t total_s, uint32_t frames, uint32_t end_s, uint8_t curve, RampPlan &plan) {
+  // Mittlerer Abstand = total/frames -> Startabstand aus dem Mittelwert der Kurve
+  if (total_s == 0 || frames == 0) {
+    DEBUG_PRINTLN("T-Lapse ramp rejected: total time and frames needed");
+    return false;
+  }
+  int64_t mean_q16 = ramp_curve_mean_q16(curve);
+  int64_t average_ms = (int64_t)total_s * 1000 / frames;
+  int64_t start_ms = (average_ms * 65536 - (int64_t)end_s * 1000 * mean_q16) / (65536 - mean_q16);
+  if (start_ms < 1) {
+    DEBUG_PRINTF("T-Lapse ramp rejected: %lu s end interval too long for %lu frames in %lu s\n", 
+                 (unsigned long)end_s, (unsigned long)frames, (unsigned long)total_s);
+    return false;
+  }
   
-  runtime.mode = TLAPSE_EXEC_MODE;
-  runtime.state = TLAPSE_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
+  plan.count = 2;
+  plan.curve = curve;
+  plan.keys[0] = {0, (uint32_t)start_ms};
+  plan.keys[1] = {total_s, end_s * 1000};
+  return true;
+}
+
+bool launch_tlapse_ramp(const RampPlan &plan) {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("T-Lapse start blocked - servo still initializing");
+    return false;
+  }
+  if (!sequence_preset_ramp(sequence_program, plan)) {
+    DEBUG_PRINTLN("T-Lapse ramp rejected: keyframes must start at 0 s and increase");
+    return false;
+  }
   
-  if (runtime.totalFrames > 0) {
-    runtime.frameInterval = (float)runtime.totalTime / runtime.totalFrames;
-  } else {
-    runtime.frameInterval = 1.0; 
+  uint32_t spacing = sequence_min_frame_spacing(sequence_program);
+  if (spacing < trigger_min_frame_interval_ms()) {
+    DEBUG_PRINTF("T-Lapse ramp rejected: frames %lu ms apart, outputs need %lu ms\n", 
+                 (unsigned long)spacing, trigger_min_frame_interval_ms());
+    return false;
   }
   
-  servo_move_to_position(servoStartPosition);
+  sequence_set_focus(sequence_program, frame_focus_lead_ms());
+  tlapse_ramp = plan;
+  
+  // Anzeige-Plan nur als Näherung (gleichmäßig) - die Deadlines kommen aus der Rampe
+  runtime.totalTime = plan.keys[plan.count - 1].at_s;
+  runtime.totalFrames = sequence_total_frames(sequence_program);
+  frame_plan_init(runtime.tlapsePlan, (unsigned long)runtime.totalTime * 1000, runtime.totalFrames);
+  
+  if (!launch_sequence(sequence_program, TLAPSE_EXEC_MODE, TLAPSE_RUNNING)) return false;
+  
+  show_tlapse_overlay();
+  
+  DEBUG_PRINTF("T-Lapse ramp started: %ds, %d frames, %s, keyframes %s\n", runtime.totalTime, 
+               runtime.totalFrames, ramp_curve_name(plan.curve), ramp_plan_string(plan).c_str());
+  return true;
+}
+
+void set_ramp_curve(int curve) {
+  if (curve < RAMP_LINEAR || curve > RAMP_EASE_IN_OUT) return;
+  app_state.ramp_curve = curve;
+  save_app_state();
+  DEBUG_PRINTF("T-Lapse ramp curve: %s\n", ramp_curve_name(curve));
+}
+
+void print_ramp_plan(const RampPlan &plan) {
+  SequenceProgram program;
+  if (!sequence_preset_ramp(program, plan)) {
+    Serial.println("T-Lapse ramp: no valid keyframes");
+    return;
+  }
+  Serial.printf("=== T-Lapse Ramp (%s) ===\n", ramp_curve_name(plan.curve));
+  for (uint8_t s = 0; s < program.count; s++) {
+    const SequenceSegment &seg = program.segments[s];
+    Serial.printf("%6lu s - %6lu s: %lu -> %lu ms, %lu frames\n", 
+                  (unsigned long)plan.keys[s].at_s, (unsigned long)plan.keys[s + 1].at_s,
+                  (unsigned long)seg.period_ms, (unsigned long)seg.end_ms, (unsigned long)seg.count);
+  }
+  Serial.printf("Total: %lu frames\n", (unsigned long)sequence_total_frames(program));
+  Serial.println("==========================");
+}
+
+bool launch_tlapse_execution(int totalSeconds, int frames) {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("T-Lapse start blocked - servo still initializing");
+    return false;
+  }
+  // Frames ganzzahlig über die Gesamtdauer verteilen (Bresenham)
+  sequence_preset_tlapse(sequence_program, (uint32_t)totalSeconds * 1000, frames > 0 ? frames : 0);
+  if (frames > 0 && sequence_min_frame_spacing(sequence_program) < trigger_min_frame_interval_ms()) {
+    DEBUG_PRINTF("T-Lapse rejected: %lu ms per frame, outputs need %lu ms (max %lu frames)\n", 
+                 (unsigned long)sequence_min_frame_spacing(sequence_program), 
+                 trigger_min_frame_interval_ms(), (unsigned long)tlapse_max_frames(totalSeconds));
+    return false;
+  }
+  
+  sequence_set_focus(sequence_program, frame_focus_lead_ms());
+  
+  runtime.totalTime = totalSeconds;    
+  runtime.totalFrames = frames;  
+  frame_plan_init(runtime.tlapsePlan, (unsigned long)runtime.totalTime * 1000, 
+                  runtime.totalFrames > 0 ? runtime.totalFrames : 0);
+  
+  if (!launch_sequence(sequence_program, TLAPSE_EXEC_MODE, TLAPSE_RUNNING)) return false;
+  
   show_tlapse_overlay();
   
-  DEBUG_PRINTF("T-Lapse started: %ds total, %d frames, %.2fs interval (Combined Servo+Elektro)\n", 
-               runtime.totalTime, runtime.totalFrames, runtime.frameInterval);
+  DEBUG_PRINTF("T-Lapse started: %ds total, %d frames, %lu ms interval (+%lu/%d) (Combined Servo+Elektro)\n", 
+               runtime.totalTime, runtime.totalFrames, runtime.tlapsePlan.step_ms,
+               (unsigned long)runtime.tlapsePlan.step_remainder, runtime.totalFrames);
+  return true;
 }
 
 void start_interval_execution() {
   DEBUG_PRINTLN("Starting Interval execution...");
   
-  runtime.intervalTime = get_option_value(STATE_INTERVAL, 0);  
+  // Interval 0 = EXT: Auslösung über den Trigger-Eingang statt nach Zeit
+  if (get_option_value(STATE_INTERVAL, 0) == 0) {
+    launch_external_trigger();
+    return;
+  }
+  launch_interval_execution(get_option_value(STATE_INTERVAL, 0));
+}
+
+bool launch_interval_execution(int intervalSeconds) {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("Interval start blocked - servo still initializing");
+    return false;
+  }
+  if (intervalSeconds < 1) {
+    // 00:00 würde jede Loop-Runde auslösen
+    intervalSeconds = 1;
+    DEBUG_PRINTLN("Interval 0s not possible - using 1s");
+  }
+  if ((unsigned long)intervalSeconds * 1000 < trigger_min_frame_interval_ms()) {
+    DEBUG_PRINTF("Interval rejected: %ds, outputs need %lu ms per frame\n", 
+                 intervalSeconds, trigger_min_frame_interval_ms());
+    return false;
+  }
+  runtime.intervalTime = intervalSeconds;  
   
-  runtime.mode = INTERVAL_EXEC_MODE;
-  runtime.state = INTERVAL_RUNNING;
-  runtime.startTime = millis();
-  runtime.currentPhaseStartTime = millis();
-  runtime.frameCount = 0;
-  runtime.logic_completed = false;
+  // Frame k liegt immer bei start + k * interval
+  sequence_preset_interval(sequence_program, (uint32_t)runtime.intervalTime * 1000);
+  sequence_set_focus(sequence_program, frame_focus_lead_ms());
+  if (!launch_sequence(sequence_program, INTERVAL_EXEC_MODE, INTERVAL_RUNNING)) return false;
   
-  servo_move_to_position(servoStartPosition);
   show_interval_overlay();
   
   DEBUG_PRINTF("Interval started: %ds interval (Combined Servo+Elektro)\n", runtime.intervalTime);
+  return true;
 }
 
-void cancel_timer_execution() {
+bool launch_sequence_execution(String text) {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("Sequence start blocked - servo still initializing");
+    return false;
+  }
+  if (!sequence_parse(text, sequence_program)) {
+    DEBUG_PRINTF("Sequence rejected: cannot parse '%s'\n", text.c_str());
+    return false;
+  }
+  
+  uint32_t spacing = sequence_min_frame_spacing(sequence_program);
+  if (spacing < trigger_min_frame_interval_ms()) {
+    DEBUG_PRINTF("Sequence rejected: frames %lu ms apart, outputs need %lu ms\n", 
+                 (unsigned long)spacing, trigger_min_frame_interval_ms());
+    return false;
+  }
+  
+  sequence_set_focus(sequence_program, frame_focus_lead_ms());
+  if (!launch_sequence(sequence_program, SEQUENCE_EXEC_MODE, SEQUENCE_RUNNING)) return false;
+  
+  show_interval_overlay();
+  
+  uint32_t frames = sequence_total_frames(sequence_program);
+  DEBUG_PRINTF("Sequence started: %d segments, %d ops, %s frames\n", sequence_program.count, 
+               sequence_code.count, frames > 0 ? String(frames).c_str() : "endless");
+  return true;
+}
+
+void start_burst_execution() {
+  DEBUG_PRINTLN("Starting Burst execution...");
+  
+  launch_burst_execution(app_state.burst_count, app_state.burst_rate_hz, app_state.burst_pulse_ms);
+}
+
+bool burst_config_valid(int count, int rate_hz, int pulse_ms) {
+  if (count < 1 || count > BURST_MAX_COUNT) return false;
+  if (rate_hz < 1 || rate_hz > BURST_MAX_RATE_HZ) return false;
+  if (pulse_ms < BURST_MIN_PULSE_MS) return false;
+  return (uint32_t)pulse_ms <= burst_max_pulse_ms(rate_hz);
+}
+
+uint32_t burst_max_pulse_ms(int rate_hz) {
+  // Impuls + LOW-Lücke müssen in eine Periode passen
+  if (rate_hz < 1) return 0;
+  uint32_t period_ms = 1000UL / rate_hz;
+  return period_ms > BURST_MIN_GAP_MS ? period_ms - BURST_MIN_GAP_MS : 0;
+}
+
+void set_burst_config(int count, int rate_hz, int pulse_ms) {
+  if (!burst_config_valid(count, rate_hz, pulse_ms)) return;
+  app_state.burst_count = count;
+  app_state.burst_rate_hz = rate_hz;
+  app_state.burst_pulse_ms = pulse_ms;
+  save_app_state();
+  DEBUG_PRINTF("Burst config: %d x %d Hz, %d ms pulse\n", count, rate_hz, pulse_ms);
+}
+
+bool launch_burst_execution(int count, int rate_hz, int pulse_ms) {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("Burst start blocked - servo still initializing");
+    return false;
+  }
+  if (!burst_config_valid(count, rate_hz, pulse_ms)) {
+    DEBUG_PRINTF("Burst rejected: %d x %d Hz, %d ms pulse (max %d Hz, pulse + %d ms gap per period)\n", 
+                 count, rate_hz, pulse_ms, BURST_MAX_RATE_HZ, BURST_MIN_GAP_MS);
+    return false;
+  }
+  
+  // Impulse auf absolutem Raster - jede Flanke kommt direkt aus der One-Shot-Uhr
+  sequence_preset_burst(sequence_program, count, 1000UL / rate_hz, pulse_ms);
+  if (!launch_sequence(sequence_program, BURST_EXEC_MODE, BURST_RUNNING)) return false;
+  
+  show_interval_overlay();
+  
+  DEBUG_PRINTF("Burst started: %d pulses, %lu ms period, %d ms pulse (Elektro)\n", 
+               count, 1000UL / rate_hz, pulse_ms);
+  return true;
+}
+
+bool launch_sequence(const SequenceProgram &program, TimerExecutionMode mode, TimerExecutionState state) {
+  // Einmal kompilieren - der Dispatch läuft danach nur noch das Op-Array ab
+  if (!sequence_compile(program, sequence_code)) {
+    DEBUG_PRINTLN("ERROR: Sequence could not be compiled - run not started");
+    return false;
+  }
+  
+  trigger_clock_lock();
+  begin_run_state(mode, state);
+  
+  sequence_reset(runtime.sequenceVM);
+  sequence_next(sequence_code, runtime.sequenceVM, runtime.nextAction);
+  schedule_sequence_action();
+  
+  servo_move_to_position(servoStartPosition);
+  trigger_clock_unlock();
+  return true;
+}
+
+void begin_run_state(TimerExecutionMode mode, TimerExecutionState state) {
+  scheduler_clear();
+  actuator_pipeline_reset();
+  elektro_deactivate_all();
+  
+  runtime.mode = mode;
+  runtime.state = state;
+  runtime.startTime = timer_start_at_us > 0 ? timer_start_at_us : trigger_clock_now_us();
+  runtime.currentPhaseStartTime = runtime.startTime;
+  runtime.frameCount = 0;
+  runtime.waiting_for_completion = false;
+  runtime.logic_completed = false;
+  runtime.missedFrames = 0;
+  runtime.lateFrames = 0;
+  runtime.scheduleShift = 0;
+  runtime.shutterLag = active_shutter_lag_ms();
+  runtime.syncMaster = timer_start_at_us > 0 ? timer_sync_master_us : 0;
+  runtime.holdActive = false;
+  runtime.paused = false;
+  runtime.pausedAt = 0;
+  runtime.pausedTotal = 0;
+  runtime.pausedFrames = 0;
+  reset_frame_log();
+  
+  timer_ui_exit_pending = false;
+  timer_logged_frame_count = 0;
+  timer_logged_missed_count = 0;
+  control_notify();
+}
+
+void cancel_timer_execution() {
   DEBUG_PRINTLN("Timer execution cancelled");
   
+  // Eingang zuerst abschalten - danach kommt keine Flanke mehr durch
+  ext_trigger_disarm();
+  
+  trigger_clock_lock();
   runtime.state = TIMER_IDLE;
   runtime.frameCount = 0;
   runtime.waiting_for_completion = false;
   runtime.logic_completed = false;
+  runtime.holdActive = false;
+  runtime.paused = false;
+  
+  // Alle geplanten Flanken verwerfen
+  scheduler_clear();
   
   // Deactivate both systems
   deactivate_all_systems();
   
+  // Aufrufer wechselt die Seite selbst
+  timer_ui_exit_pending = false;
+  timer_logged_frame_count = 0;
+  timer_logged_missed_count = 0;
+  trigger_clock_unlock();
+  control_notify();
+  
   hide_timer_overlays();
 }
 
+bool timer_run_armed() {
+  return runtime.state != TIMER_IDLE && trigger_clock_now_us() < runtime.startTime;
+}
+
+bool start_execution_at(uint64_t start_us, TimerExecutionMode mode) {
+  // Startet den Lauf der Seite mit startTime = start_us - Planung, Schlaf und Checkpoints wie gewohnt
+  timer_start_at_us = start_us;
+  switch (mode) {
+    case TIMER_EXEC_MODE:    start_timer_execution(); break;
+    case TLAPSE_EXEC_MODE:   start_tlapse_execution(); break;
+    case INTERVAL_EXEC_MODE: start_interval_execution(); break;
+    default: break;
+  }
+  bool armed = runtime.state != TIMER_IDLE && runtime.startTime == start_us;
+  timer_start_at_us = 0;
+  return armed;
+}
+
 // =============================================================================
-// TIMER UPDATE FUNCTIONS - VEREINFACHT für synchrone Ansteuerung
+// PAUSE / RESUME - Frames anhalten, Zähler und Statistik bleiben erhalten
 // =============================================================================
-void update_timer_execution() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedTotal = (currentTime - runtime.startTime) / 1000;
-  unsigned long elapsedPhase = (currentTime - runtime.currentPhaseStartTime) / 1000;
+bool run_pausable() {
+  return (runtime.state == TLAPSE_RUNNING || runtime.state == INTERVAL_RUNNING || 
+          runtime.state == SEQUENCE_RUNNING) && !runtime.logic_completed && !timer_run_armed();
+}
+
+bool pause_execution() {
+  trigger_clock_lock();
+  bool pausable = run_pausable() && !runtime.paused;
+  if (pausable) {
+    runtime.paused = true;
+    runtime.pausedAt = trigger_clock_now_us();
+    // Nur den nächsten Frame austragen - Servo-Rückweg, Release-/Bulb-Ende laufen normal zu Ende
+    scheduler_remove(EVENT_RELEASE_START);
+    scheduler_remove(EVENT_FOCUS_START);
+    scheduler_rearm();
+  }
+  trigger_clock_unlock();
   
-  switch (runtime.state) {
-    case TIMER_DELAY_RUNNING: {
-      // Elektro-Focus-Scheduling für Timer-Modus
-      float time_to_release = runtime.totalDelayTime - elapsedPhase;
-      
-      // Fokus scheduling
-      if (time_to_release <= elektro_focus_lead_time && 
-          elektro_state.focus_scheduled_time == 0 && 
-          !elektro_state.focus_active) {
-        
-        if (elektro_focus_lead_time >= time_to_release) {
-          elektro_activate_focus();
-          DEBUG_PRINTF("Elektro: Focus activated immediately (lead time %.1fs >= remaining %.1fs)\n", 
-                      elektro_focus_lead_time, time_to_release);
-        } else {
-          elektro_state.focus_scheduled_time = currentTime + ((time_to_release - elektro_focus_lead_time) * 1000);
-          DEBUG_PRINTF("Elektro: Focus scheduled in %.1fs\n", time_to_release - elektro_focus_lead_time);
-        }
+  if (pausable) {
+    DEBUG_PRINTF("Run paused after %d frames\n", runtime.frameCount);
+  }
+  return pausable;
+}
+
+bool resume_execution(bool shift) {
+  trigger_clock_lock();
+  if (!runtime.paused) {
+    trigger_clock_unlock();
+    return false;
+  }
+  
+  uint64_t now = trigger_clock_now_us();
+  uint64_t paused_us = now - runtime.pausedAt;
+  runtime.paused = false;
+  runtime.pausedTotal += paused_us;
+  int skipped_before = runtime.pausedFrames;
+  
+  if (shift) {
+    // Restlicher Plan um die Pausendauer nach hinten - wie CATCHUP_SHIFT
+    runtime.scheduleShift += paused_us;
+  } else {
+    skip_paused_frames(now);
+  }
+  schedule_sequence_action();
+  scheduler_rearm();
+  int skipped = runtime.pausedFrames - skipped_before;
+  trigger_clock_unlock();
+  
+  DEBUG_PRINTF("Run resumed after %lu s pause (%s, %d frames skipped)\n", 
+               (unsigned long)(paused_us / 1000000), shift ? "plan shifted" : "original grid", skipped);
+  return true;
+}
+
+void skip_paused_frames(uint64_t now) {
+  // Altes Raster: was in die Pause fiel, wird übersprungen - weder verpasst noch verspätet
+  SequenceAction &action = runtime.nextAction;
+  while (action.type != SEQ_ACTION_END) {
+    if (action.type == SEQ_ACTION_FRAME) {
+      if (!time_reached(now, sequence_action_deadline(action))) break;
+      runtime.pausedFrames++;
+    }
+    sequence_next(sequence_code, runtime.sequenceVM, action);
+  }
+}
+
+void set_resume_shift(bool shift) {
+  app_state.resume_shift = shift;
+  save_app_state();
+  DEBUG_PRINTF("Resume after pause: %s\n", shift ? "shift plan by the pause" : "keep original grid");
+}
+
+unsigned long completion_grace_ms() {
+  return (unsigned long)outputs_max_width_ms() + 500;
+}
+
+void finish_execution_logic() {
+  runtime.logic_completed = true;
+  
+  if (is_any_system_active()) {
+    runtime.waiting_for_completion = true;
+    runtime.completion_timeout = trigger_clock_now_us() + MS_TO_US(completion_grace_ms());
+    scheduler_push(EVENT_COMPLETE, runtime.completion_timeout);
+    
+    switch (runtime.mode) {
+      case TIMER_EXEC_MODE:    runtime.state = TIMER_COMPLETING; break;
+      case TLAPSE_EXEC_MODE:   runtime.state = TLAPSE_COMPLETING; break;
+      case INTERVAL_EXEC_MODE: runtime.state = INTERVAL_COMPLETING; break;
+      case SEQUENCE_EXEC_MODE: runtime.state = SEQUENCE_COMPLETING; break;
+      case BURST_EXEC_MODE:    runtime.state = BURST_COMPLETING; break;
+      case EXTERNAL_EXEC_MODE: break;   // Endet nur per Cancel
+    }
+    EDGE_DEBUG_PRINTLN("Logic complete - waiting for final completion");
+  } else {
+    end_execution_run();
+  }
+}
+
+// =============================================================================
+// SEQUENCE EXECUTOR - ein Dispatcher für alle Modi
+// =============================================================================
+uint64_t sequence_action_deadline(const SequenceAction &action) {
+  // Programmzeit (ms) -> absolute Deadline (µs). SHIFT verschiebt den Rest des Programms,
+  // Frames um den Shutter-Lag vorziehen, damit die Belichtung auf dem Raster liegt
+  uint64_t at = action.at_ms;
+  if (action.type == SEQ_ACTION_FRAME) {
+    at = at > runtime.shutterLag ? at - runtime.shutterLag : 0;
+  }
+  if (runtime.syncMaster != 0 && time_sync_valid()) {
+    // Synchronisierter Lauf: Programmzeit ist Masterzeit - jeder Sync korrigiert den Rest des Plans
+    return time_sync_master_to_local(runtime.syncMaster + (int64_t)runtime.scheduleShift + (int64_t)MS_TO_US(at));
+  }
+  return runtime.startTime + runtime.scheduleShift + MS_TO_US(at);
+}
+
+void schedule_sequence_action() {
+  const SequenceAction &action = runtime.nextAction;
+  
+  if (action.type == SEQ_ACTION_CONTINUE) {
+    // Budget erschöpft - im nächsten Dispatch weiterrechnen
+    scheduler_push(EVENT_RELEASE_START, trigger_clock_now_us());
+    return;
+  }
+  
+  uint64_t due = sequence_action_deadline(action);
+  if (action.type == SEQ_ACTION_FRAME && action.focus_ms > 0) {
+    schedule_focus_before(due, action.focus_ms);
+  }
+  scheduler_push(EVENT_RELEASE_START, due);
+}
+
+void execute_sequence_frame(const SequenceAction &action, uint64_t now) {
+  runtime.frameCount++;
+  runtime.currentPhaseStartTime = now;
+  
+  if (action.hold_ms > 0) {
+    // Bulb-Frame - Servo + Release gehalten, RELEASE_END gibt beide frei
+    if (runtime.mode == TIMER_EXEC_MODE) runtime.state = TIMER_RELEASE_RUNNING;
+    runtime.holdActive = true;
+    activate_release_mode(action.hold_ms);
+    EDGE_DEBUG_PRINTF("Sequence: Frame %lu bulb ON for %lums\n", (unsigned long)action.frame, (unsigned long)action.hold_ms);
+  } else if (action.pulse_ms > 0) {
+    // Burst-Impuls: nur Elektro-Release, am Servo und an der Kanal-Warteschlange vorbei
+    actuator_channels[ACTUATOR_ELEKTRO].busy_until = now + MS_TO_US(action.pulse_ms + BURST_MIN_GAP_MS);
+    elektro_activate_release(MS_TO_US(action.pulse_ms));
+  } else {
+    activate_trigger();  // Aktiviert BEIDE Systeme
+    EDGE_DEBUG_PRINTF("Sequence: Frame %lu triggered (Combined Servo+Elektro)\n", (unsigned long)action.frame);
+  }
+}
+
+void on_sequence_event() {
+  if (runtime.state == TIMER_IDLE || runtime.logic_completed || runtime.paused) return;
+  
+  uint64_t now = trigger_clock_now_us();
+  bool fired_late = false;
+  
+  // Alle fälligen Aktionen abarbeiten - überfällige Frames entscheidet die Catch-up-Policy
+  for (int step = 0; step < SEQUENCE_STEP_BUDGET; step++) {
+    SequenceAction &action = runtime.nextAction;
+    
+    if (action.type != SEQ_ACTION_CONTINUE) {
+      uint64_t due = sequence_action_deadline(action);
+      if (!time_reached(now, due)) {
+        schedule_sequence_action();
+        return;
       }
       
-      // Check if delay phase is complete
-      if (elapsedPhase >= runtime.totalDelayTime) {
-        if (runtime.totalReleaseTime == 0) {
-          // TRIGGER MODE - aktiviert beide Systeme
-          activate_trigger();
-          runtime.frameCount = 1;
-          runtime.logic_completed = true;
-          runtime.waiting_for_completion = true;
-          runtime.completion_timeout = millis() + max(servoActivationTime, elektro_release_duration) * 1000 + 500;
-          runtime.state = TIMER_COMPLETING;
-          DEBUG_PRINTLN("Timer: Delay complete, combined trigger activated");
-        } else {
-          // RELEASE MODE - aktiviert beide Systeme für Release-Dauer
-          runtime.state = TIMER_RELEASE_RUNNING;
-          runtime.currentPhaseStartTime = millis();
-          runtime.frameCount = 1;
-          
-          activate_release_mode();
-          DEBUG_PRINTF("Timer: Delay complete, combined release ON for %ds\n", runtime.totalReleaseTime);
-        }
+      if (action.type == SEQ_ACTION_END) {
+        EDGE_DEBUG_PRINTF("Sequence logic complete: %d frames taken, %d missed\n", 
+                          runtime.frameCount, runtime.missedFrames);
+        finish_execution_logic();
+        return;
       }
-      break;
-    }
       
-    case TIMER_RELEASE_RUNNING: {
-      if (elapsedPhase >= runtime.totalReleaseTime) {
-        deactivate_all_systems();
-        DEBUG_PRINTLN("Timer execution complete - all systems deactivated");
-        cancel_timer_execution();
-        show_current_page();
-        return;
+      bool late = !time_reached(due + MS_TO_US(FRAME_LATE_TOLERANCE_MS), now);
+      if (frame_should_fire(action.frame, due, now, !fired_late)) {
+        execute_sequence_frame(action, now);
+        if (late) fired_late = true;
       }
-      break;
     }
+    
+    sequence_next(sequence_code, runtime.sequenceVM, action);
   }
   
-  update_timer_overlay_display();
+  // Sehr langer Rückstand - Rest im nächsten Dispatch
+  scheduler_push(EVENT_RELEASE_START, now);
+}
+
+// =============================================================================
+// SHUTTER-LAG MESSUNG - Release auslösen, X-Sync-Flanke der Kamera stoppen
+// =============================================================================
+volatile unsigned long lag_measure_edge_us = 0;
+bool lag_measure_running = false;
+unsigned long lag_measure_start_us = 0;
+
+void IRAM_ATTR lag_sense_isr() {
+  if (lag_measure_edge_us == 0) lag_measure_edge_us = micros();
 }
 
-void update_tlapse_execution() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedTotal = (currentTime - runtime.startTime) / 1000;
+bool lag_measure_start() {
+  if (runtime.state != TIMER_IDLE || lag_measure_running) return false;
   
-  int expectedFrames = (int)(elapsedTotal / runtime.frameInterval);
+  pinMode(LAG_SENSE_PIN, INPUT_PULLUP);
+  lag_measure_edge_us = 0;
+  attachInterrupt(digitalPinToInterrupt(LAG_SENSE_PIN), lag_sense_isr, FALLING);
+  lag_measure_running = true;
   
-  // Trigger frame if needed
-  if (expectedFrames > runtime.frameCount && runtime.frameCount < runtime.totalFrames) {
-    activate_trigger();  // Aktiviert BEIDE Systeme
-    runtime.frameCount++;
-    DEBUG_PRINTF("T-Lapse: Frame %d/%d triggered (Combined Servo+Elektro)\n", 
-                 runtime.frameCount, runtime.totalFrames);
-  }
+  trigger_clock_lock();
+  lag_measure_start_us = micros();
+  elektro_activate_release(elektro_release_us);
+  trigger_clock_unlock();
   
-  // Check if T-Lapse logic is complete
-  if ((elapsedTotal >= runtime.totalTime || runtime.frameCount >= runtime.totalFrames) && 
-      !runtime.logic_completed) {
-    
-    runtime.logic_completed = true;
-    DEBUG_PRINTF("T-Lapse logic complete: %d frames taken\n", runtime.frameCount);
+  DEBUG_PRINTF("Lag measurement started - waiting for X-sync on GPIO %d\n", LAG_SENSE_PIN);
+  return true;
+}
+
+void lag_measure_update() {
+  if (!lag_measure_running) return;
+  
+  unsigned long edge_us = lag_measure_edge_us;
+  if (edge_us != 0) {
+    detachInterrupt(digitalPinToInterrupt(LAG_SENSE_PIN));
+    lag_measure_running = false;
     
-    if (is_any_system_active()) {
-      runtime.waiting_for_completion = true;
-      runtime.completion_timeout = millis() + max(servoActivationTime, elektro_release_duration) * 1000 + 500;
-      runtime.state = TLAPSE_COMPLETING;
-      DEBUG_PRINTLN("T-Lapse waiting for final completion");
-    } else {
-      cancel_timer_execution();
-      show_current_page();
+    // Auf ganze ms gerundet - in das aktive Profil übernehmen
+    int lag_ms = (int)((edge_us - lag_measure_start_us + 500) / 1000);
+    if (lag_profile_set(lag_profiles.active, "", min(lag_ms, LAG_MAX_MS))) {
+      DEBUG_PRINTF("Shutter lag measured: %d ms (profile %d)\n", lag_ms, lag_profiles.active);
+      send_ble_response("OK:LAG_MEASURED:" + String(lag_ms));
+    }
+  } else if (micros() - lag_measure_start_us > (unsigned long)LAG_MEASURE_TIMEOUT_MS * 1000) {
+    detachInterrupt(digitalPinToInterrupt(LAG_SENSE_PIN));
+    lag_measure_running = false;
+    DEBUG_PRINTLN("Lag measurement timeout - no X-sync edge (check cable)");
+    send_ble_response("ERROR:LAG_TIMEOUT");
+  }
+}
+
+// =============================================================================
+// EXTERNAL TRIGGER - Flanke am Eingang löst direkt aus der ISR aus
+// =============================================================================
+// Die ISR stempelt die Flanke und setzt den Release-Pin ohne Umweg über Loop oder
+// Scheduler. Buchführung (Release-Ende, Servo, Frame-Log, Latenz) übernimmt ein
+// eigener Task mit hoher Priorität, den die ISR per Notification weckt. Mit
+// Verzögerung stellt der Task einen esp_timer One-Shot auf Flanke + Verzögerung;
+// dessen Callback setzt den Pin - kein aktives Warten über dem esp_timer-Task.
+struct ExtTriggerState {
+  volatile bool armed;
+  volatile bool pending;            // Flanke angenommen, Task noch nicht fertig
+  volatile bool fired;              // Release-Pin gesetzt
+  volatile uint64_t edge_us;        // Flanke (Eintritt in die ISR)
+  volatile uint64_t fire_us;        // Release-Pin gesetzt
+  volatile uint64_t lockout_until;  // Flanken davor werden verworfen
+  volatile uint64_t busy_until;     // Elektro-Kanal frei ab (Spiegel für die ISR)
+  volatile uint32_t ignored;        // Verworfene Flanken (Sperrzeit, Kanal belegt)
+  uint32_t delay_us;
+  uint32_t lockout_us;
+  
+  // Latenz Flanke (+ Verzögerung) -> Release-Pin
+  uint32_t latency_last_us;
+  uint32_t latency_min_us;
+  uint32_t latency_max_us;
+  uint64_t latency_sum_us;
+  uint32_t latency_count;
+};
+
+ExtTriggerState ext_trigger = {};
+
+// 64-Bit-Felder sind auf dem C6 nicht atomar - ISR, Task und Loop schreiben
+// lockout_until/busy_until/edge_us nur unter diesem Spinlock
+portMUX_TYPE ext_trigger_mux = portMUX_INITIALIZER_UNLOCKED;
+
+#if TRIGGER_CLOCK_HARDWARE
+TaskHandle_t ext_trigger_task_handle = nullptr;
+
+esp_timer_handle_t ext_trigger_fire_timer = nullptr;   // Verzögerte Auslösung
+
+void ext_trigger_task(void *arg) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (ext_trigger.pending) ext_trigger_service();
+  }
+}
+#endif
+
+uint64_t IRAM_ATTR ext_trigger_stamp() {
+#if TRIGGER_CLOCK_HARDWARE
+  // esp_timer_get_time liegt im IRAM - trigger_clock_now_us nicht zwingend
+  return (uint64_t)(esp_timer_get_time() + trigger_clock_epoch_us);
+#else
+  return trigger_clock_now_us();
+#endif
+}
+
+void IRAM_ATTR ext_trigger_fire_pin() {
+#if defined(ESP32)
+  REG_WRITE(GPIO_OUT_W1TS_REG, 1UL << ELEKTRO_RELEASE_PIN);
+#else
+  digitalWrite(ELEKTRO_RELEASE_PIN, HIGH);
+#endif
+}
+
+#if TRIGGER_CLOCK_HARDWARE
+void ext_trigger_fire_cb(void *arg) {
+  // esp_timer-Task: nur den Pin setzen, Buchführung wieder im ext_trigger-Task
+  if (!ext_trigger.armed || !ext_trigger.pending) return;
+  ext_trigger_fire_pin();
+  ext_trigger.fire_us = ext_trigger_stamp();
+  ext_trigger.fired = true;
+  xTaskNotifyGive(ext_trigger_task_handle);
+}
+#endif
+
+bool IRAM_ATTR ext_trigger_accept(uint64_t edge_us) {
+  // Aufrufer hält ext_trigger_mux
+  if (!ext_trigger.armed) return false;
+  if (ext_trigger.pending || edge_us < ext_trigger.lockout_until || 
+      edge_us + ext_trigger.delay_us < ext_trigger.busy_until) {
+    ext_trigger.ignored++;
+    return false;
+  }
+  
+  ext_trigger.edge_us = edge_us;
+  ext_trigger.lockout_until = edge_us + ext_trigger.lockout_us;
+  ext_trigger.fired = false;
+  ext_trigger.pending = true;
+  
+  if (ext_trigger.delay_us == 0) {
+    ext_trigger_fire_pin();
+    ext_trigger.fire_us = ext_trigger_stamp();
+    ext_trigger.fired = true;
+  }
+  return true;
+}
+
+void IRAM_ATTR ext_trigger_isr() {
+  portENTER_CRITICAL_ISR(&ext_trigger_mux);
+  bool accepted = ext_trigger_accept(ext_trigger_stamp());
+  portEXIT_CRITICAL_ISR(&ext_trigger_mux);
+  if (!accepted) return;
+  
+#if TRIGGER_CLOCK_HARDWARE
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(ext_trigger_task_handle, &woken);
+  portYIELD_FROM_ISR(woken);
+#else
+  ext_trigger_service();
+#endif
+}
+
+void ext_trigger_service() {
+  if (!ext_trigger.fired && ext_trigger.armed) {
+#if TRIGGER_CLOCK_HARDWARE
+    // Noch nicht fällig: One-Shot stellen - ext_trigger_fire_cb() weckt den Task wieder
+    uint64_t target = ext_trigger.edge_us + ext_trigger.delay_us;
+    uint64_t now = ext_trigger_stamp();
+    if (!time_reached(now, target) && esp_timer_start_once(ext_trigger_fire_timer, target - now) == ESP_OK) {
       return;
     }
+#endif
+    ext_trigger_fire_pin();
+    ext_trigger.fire_us = ext_trigger_stamp();
+    ext_trigger.fired = true;
   }
   
-  update_tlapse_overlay_display();
+  // Wie im Dispatch: keine Serial-Ausgabe aus diesem Kontext (ext_trigger-Task ist
+  // als Flanken-Task registriert, der Host-Pfad setzt das Flag selbst)
+  trigger_clock_lock();
+#if !TRIGGER_CLOCK_HARDWARE
+  trigger_clock_callback_running = true;
+#endif
+  ext_trigger_complete();
+#if !TRIGGER_CLOCK_HARDWARE
+  trigger_clock_callback_running = false;
+#endif
+  trigger_clock_unlock();
+  control_notify();
 }
 
-void update_interval_execution() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedPhase = (currentTime - runtime.currentPhaseStartTime) / 1000;
+void ext_trigger_complete() {
+  if (!ext_trigger.fired) {
+    // Während der Verzögerung abgebrochen
+    ext_trigger.pending = false;
+    return;
+  }
+  if (!ext_trigger.armed || runtime.state != EXTERNAL_ARMED) {
+    // Abbruch kam nach der Auslösung - Pin nicht stehen lassen
+    digitalWrite(ELEKTRO_RELEASE_PIN, LOW);
+    ext_trigger.pending = false;
+    return;
+  }
   
-  if (elapsedPhase >= runtime.intervalTime) {
-    activate_trigger();  // Aktiviert BEIDE Systeme
-    runtime.frameCount++;
-    runtime.currentPhaseStartTime = millis();
-    
-    DEBUG_PRINTF("Interval: Frame %d triggered (Combined Servo+Elektro)\n", runtime.frameCount);
+  uint64_t fire_us = ext_trigger.fire_us;
+  uint64_t planned = ext_trigger.edge_us + ext_trigger.delay_us;
+  
+  // Pin steht schon - Release-Ende und Belegung wie bei actuator_fire nachtragen
+  elektro_state.release_active = true;
+  elektro_state.release_start_time = fire_us;
+  scheduler_push(EVENT_RELEASE_END, fire_us + elektro_release_us);
+  actuator_channels[ACTUATOR_ELEKTRO].busy_until = fire_us + MS_TO_US(actuator_busy_ms(ACTUATOR_ELEKTRO));
+  portENTER_CRITICAL(&ext_trigger_mux);
+  ext_trigger.busy_until = actuator_channels[ACTUATOR_ELEKTRO].busy_until;
+  portEXIT_CRITICAL(&ext_trigger_mux);
+  
+  // Servo ist ohnehin um Größenordnungen langsamer - normaler Pipeline-Weg
+  if (app_state.ext_servo && output_enabled(ACTUATOR_SERVO) && output_is_servo(ACTUATOR_SERVO)) {
+    actuator_request(ACTUATOR_SERVO);
   }
   
-  update_interval_overlay_display();
+  runtime.frameCount++;
+  record_frame(runtime.frameCount, planned, fire_us, FRAME_ON_TIME);
+  
+  uint32_t latency = (uint32_t)(fire_us - planned);
+  ext_trigger.latency_last_us = latency;
+  if (ext_trigger.latency_count == 0 || latency < ext_trigger.latency_min_us) ext_trigger.latency_min_us = latency;
+  if (latency > ext_trigger.latency_max_us) ext_trigger.latency_max_us = latency;
+  ext_trigger.latency_sum_us += latency;
+  ext_trigger.latency_count++;
+  
+  ext_trigger.pending = false;
+}
+
+bool launch_external_trigger() {
+  if (!servo_initialization_complete) {
+    DEBUG_PRINTLN("External trigger blocked - servo still initializing");
+    return false;
+  }
+  if (timer_start_at_us > 0) {
+    // Geplanter Start braucht ein Zeitraster - EXT hat keins
+    DEBUG_PRINTLN("External trigger cannot be armed for a scheduled start");
+    return false;
+  }
+  if (!output_enabled(ACTUATOR_ELEKTRO) || output_is_servo(ACTUATOR_ELEKTRO)) {
+    DEBUG_PRINTLN("External trigger needs the opto release on output 1");
+    return false;
+  }
+  
+#if TRIGGER_CLOCK_HARDWARE
+  if (!ext_trigger_task_handle &&
+      xTaskCreate(ext_trigger_task, "ext_trigger", 3072, nullptr, configMAX_PRIORITIES - 2, 
+                  &ext_trigger_task_handle) != pdPASS) {
+    ext_trigger_task_handle = nullptr;
+    DEBUG_PRINTLN("ERROR: External trigger task could not be created");
+    return false;
+  }
+  trigger_clock_register_edge_task(ext_trigger_task_handle);
+  if (!ext_trigger_fire_timer) {
+    esp_timer_create_args_t args = {};
+    args.callback = ext_trigger_fire_cb;
+    args.arg = nullptr;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "ext_trigger";
+    if (esp_timer_create(&args, &ext_trigger_fire_timer) != ESP_OK) {
+      ext_trigger_fire_timer = nullptr;
+      DEBUG_PRINTLN("ERROR: External trigger timer could not be created");
+      return false;
+    }
+  }
+#endif
+  
+  trigger_clock_lock();
+  begin_run_state(EXTERNAL_EXEC_MODE, EXTERNAL_ARMED);
+  servo_move_to_position(servoStartPosition);
+  
+  portENTER_CRITICAL(&ext_trigger_mux);
+  ext_trigger.delay_us = MS_TO_US((uint32_t)app_state.ext_delay_ms);
+  ext_trigger.lockout_us = MS_TO_US((uint32_t)app_state.ext_lockout_ms);
+  ext_trigger.pending = false;
+  ext_trigger.fired = false;
+  ext_trigger.lockout_until = 0;
+  ext_trigger.busy_until = 0;
+  portEXIT_CRITICAL(&ext_trigger_mux);
+  ext_trigger.ignored = 0;
+  ext_trigger.latency_last_us = 0;
+  ext_trigger.latency_min_us = 0;
+  ext_trigger.latency_max_us = 0;
+  ext_trigger.latency_sum_us = 0;
+  ext_trigger.latency_count = 0;
+  ext_trigger.armed = true;
+  trigger_clock_unlock();
+  
+  pinMode(EXT_TRIGGER_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(EXT_TRIGGER_PIN), ext_trigger_isr, FALLING);
+  
+  show_interval_overlay();
+  
+  DEBUG_PRINTF("External trigger armed on GPIO %d: delay %d ms, lockout %d ms, servo %s\n", EXT_TRIGGER_PIN,
+               app_state.ext_delay_ms, app_state.ext_lockout_ms, app_state.ext_servo ? "ON" : "OFF");
+  return true;
+}
+
+void ext_trigger_disarm() {
+  if (!ext_trigger.armed) return;
+  
+  detachInterrupt(digitalPinToInterrupt(EXT_TRIGGER_PIN));
+  ext_trigger.armed = false;
+#if TRIGGER_CLOCK_HARDWARE
+  // Verzögerung läuft noch: One-Shot stoppen, es wurde nichts ausgelöst
+  if (ext_trigger_fire_timer) esp_timer_stop(ext_trigger_fire_timer);
+#endif
+  if (!ext_trigger.fired) ext_trigger.pending = false;
+  
+  if (ext_trigger.latency_count > 0) {
+    DEBUG_PRINTF("External trigger disarmed: %lu fired, %lu ignored, latency avg %lu us (max %lu us)\n",
+                 (unsigned long)ext_trigger.latency_count, (unsigned long)ext_trigger.ignored,
+                 (unsigned long)(ext_trigger.latency_sum_us / ext_trigger.latency_count),
+                 (unsigned long)ext_trigger.latency_max_us);
+  } else {
+    DEBUG_PRINTLN("External trigger disarmed");
+  }
+}
+
+bool ext_trigger_simulate() {
+  // Software-Flanke zum Testen ohne Sensor - gleicher Weg wie die ISR, aber aus dem Loop
+  portENTER_CRITICAL(&ext_trigger_mux);
+  bool accepted = ext_trigger_accept(ext_trigger_stamp());
+  portEXIT_CRITICAL(&ext_trigger_mux);
+  if (!accepted) return false;
+#if TRIGGER_CLOCK_HARDWARE
+  xTaskNotifyGive(ext_trigger_task_handle);
+#else
+  ext_trigger_service();
+#endif
+  return true;
+}
+
+bool ext_trigger_config_valid(int delay_ms, int lockout_ms) {
+  return delay_ms >= 0 && delay_ms <= EXT_TRIGGER_MAX_DELAY_MS && 
+         lockout_ms >= 0 && lockout_ms <= EXT_TRIGGER_MAX_LOCKOUT_MS;
+}
+
+void set_ext_trigger_config(int delay_ms, int lockout_ms, bool servo) {
+  if (!ext_trigger_config_valid(delay_ms, lockout_ms)) return;
+  app_state.ext_delay_ms = delay_ms;
+  app_state.ext_lockout_ms = lockout_ms;
+  app_state.ext_servo = servo;
+  save_app_state();
+  DEBUG_PRINTF("External trigger: delay %d ms, lockout %d ms, servo %s\n", 
+               delay_ms, lockout_ms, servo ? "ON" : "OFF");
+}
+
+String ext_trigger_status_string() {
+  // Format: ARMED|OFF:delay_ms:lockout_ms:servo:fired:ignored:last_us:min_us:avg_us:max_us
+  uint32_t count = ext_trigger.latency_count;
+  String status = ext_trigger.armed ? "ARMED" : "OFF";
+  status += ":" + String(app_state.ext_delay_ms) + ":" + String(app_state.ext_lockout_ms);
+  status += ":" + String(app_state.ext_servo ? 1 : 0);
+  status += ":" + String((unsigned long)count) + ":" + String((unsigned long)ext_trigger.ignored);
+  status += ":" + String((unsigned long)ext_trigger.latency_last_us);
+  status += ":" + String((unsigned long)ext_trigger.latency_min_us);
+  status += ":" + String((unsigned long)(count > 0 ? ext_trigger.latency_sum_us / count : 0));
+  status += ":" + String((unsigned long)ext_trigger.latency_max_us);
+  return status;
+}
+
+void print_ext_trigger_status() {
+  Serial.println("=== External Trigger ===");
+  Serial.printf("Input: GPIO %d (falling edge), %s\n", EXT_TRIGGER_PIN, ext_trigger.armed ? "ARMED" : "off");
+  Serial.printf("Delay %d ms, lockout %d ms, servo %s\n", app_state.ext_delay_ms, app_state.ext_lockout_ms, 
+                app_state.ext_servo ? "ON" : "OFF");
+  Serial.printf("Fired %lu, ignored %lu\n", (unsigned long)ext_trigger.latency_count, 
+                (unsigned long)ext_trigger.ignored);
+  if (ext_trigger.latency_count > 0) {
+    Serial.printf("Latency edge -> release: last %lu us, min %lu us, avg %lu us, max %lu us\n",
+                  (unsigned long)ext_trigger.latency_last_us, (unsigned long)ext_trigger.latency_min_us,
+                  (unsigned long)(ext_trigger.latency_sum_us / ext_trigger.latency_count),
+                  (unsigned long)ext_trigger.latency_max_us);
+  }
+  Serial.println("========================");
+}
+
+// =============================================================================
+// MISSED-FRAME HANDLING
+// =============================================================================
+bool frame_should_fire(uint32_t slot, uint64_t planned, uint64_t now, bool allow_late) {
+  uint64_t lateness = time_reached(now, planned) ? now - planned : 0;
+  
+  if (lateness <= MS_TO_US(FRAME_LATE_TOLERANCE_MS)) {
+    record_frame(slot, planned, now, FRAME_ON_TIME);
+    return true;
+  }
+  
+  switch (app_state.catchup_policy) {
+    case CATCHUP_FIRE_NOW:
+      // Nur ein verspäteter Frame pro Dispatch - der Rest des Rückstands gilt als verpasst
+      if (!allow_late) {
+        record_missed_frame(slot, planned);
+        return false;
+      }
+      runtime.lateFrames++;
+      record_frame(slot, planned, now, FRAME_LATE);
+      EDGE_DEBUG_PRINTF("Frame %lu fired late (+%lums)\n", (unsigned long)slot, (unsigned long)US_TO_MS(lateness));
+      return true;
+      
+    case CATCHUP_SHIFT:
+      // Alle folgenden Deadlines wandern um die Verspätung nach hinten
+      runtime.scheduleShift += lateness;
+      runtime.lateFrames++;
+      record_frame(slot, planned, now, FRAME_LATE);
+      EDGE_DEBUG_PRINTF("Frame %lu fired late, plan shifted by %lums\n", (unsigned long)slot, (unsigned long)US_TO_MS(lateness));
+      return true;
+      
+    default:
+      record_missed_frame(slot, planned);
+      EDGE_DEBUG_PRINTF("Frame %lu skipped (%lums overdue)\n", (unsigned long)slot, (unsigned long)US_TO_MS(lateness));
+      return false;
+  }
+}
+
+void record_frame(uint32_t slot, uint64_t planned, uint64_t actual, uint8_t status) {
+  FrameRecord &record = frame_log[frame_log_head];
+  record.slot = slot;
+  record.planned = planned;
+  record.actual = actual;
+  record.status = status;
+  
+  frame_log_head = (frame_log_head + 1) % FRAME_LOG_SIZE;
+  frame_log_count++;
+}
+
+void record_missed_frame(uint32_t slot, uint64_t planned) {
+  runtime.missedFrames++;
+  record_frame(slot, planned, 0, FRAME_MISSED);
+}
+
+void reset_frame_log() {
+  frame_log_head = 0;
+  frame_log_count = 0;
+}
+
+void set_catchup_policy(int policy) {
+  if (policy < CATCHUP_SKIP || policy > CATCHUP_SHIFT) return;
+  app_state.catchup_policy = policy;
+  save_app_state();
+  DEBUG_PRINTF("Catch-up policy: %s\n", catchup_policy_name(policy));
+}
+
+const char* catchup_policy_name(int policy) {
+  switch (policy) {
+    case CATCHUP_FIRE_NOW: return "FIRE_NOW";
+    case CATCHUP_SHIFT:    return "SHIFT";
+    default:               return "SKIP";
+  }
 }
 
 // =============================================================================
@@ -788,9 +2146,28 @@ void create_timer_overlays() {
   lv_obj_set_style_text_color(tlapse_overlay_frame_counter, lv_color_hex(COLOR_TEXT_PRIMARY), 0);
   lv_obj_center(tlapse_overlay_frame_counter);
   
+  tlapse_overlay_missed_label = lv_label_create(tlapse_overlay);
+  lv_label_set_text(tlapse_overlay_missed_label, "");
+  lv_obj_set_style_text_font(tlapse_overlay_missed_label, &lv_font_montserrat_16, 0);
+  lv_obj_set_style_text_color(tlapse_overlay_missed_label, lv_color_hex(COLOR_BTN_WARNING), 0);
+  lv_obj_align(tlapse_overlay_missed_label, LV_ALIGN_CENTER, 0, 64);
+  
+  // Pause/Resume links neben Cancel - zusammen so breit wie vorher Cancel allein
+  lv_obj_t *tlapse_pause_btn = lv_btn_create(tlapse_overlay);
+  lv_obj_set_size(tlapse_pause_btn, 46, 46);
+  lv_obj_align(tlapse_pause_btn, LV_ALIGN_BOTTOM_MID, -52, -16);
+  lv_obj_set_style_bg_color(tlapse_pause_btn, lv_color_hex(COLOR_BTN_SECONDARY), 0);
+  lv_obj_add_event_cb(tlapse_pause_btn, run_pause_cb, LV_EVENT_CLICKED, NULL);
+  
+  tlapse_overlay_pause_label = lv_label_create(tlapse_pause_btn);
+  lv_label_set_text(tlapse_overlay_pause_label, LV_SYMBOL_PAUSE);
+  lv_obj_set_style_text_color(tlapse_overlay_pause_label, lv_color_hex(COLOR_TEXT_PRIMARY), 0);
+  lv_obj_set_style_text_font(tlapse_overlay_pause_label, &lv_font_montserrat_20, 0);
+  lv_obj_center(tlapse_overlay_pause_label);
+  
   tlapse_overlay_cancel_btn = lv_btn_create(tlapse_overlay);
-  lv_obj_set_size(tlapse_overlay_cancel_btn, 150, 46);
-  lv_obj_align(tlapse_overlay_cancel_btn, LV_ALIGN_BOTTOM_MID, 0, -16);
+  lv_obj_set_size(tlapse_overlay_cancel_btn, 96, 46);
+  lv_obj_align(tlapse_overlay_cancel_btn, LV_ALIGN_BOTTOM_MID, 27, -16);
   lv_obj_set_style_bg_color(tlapse_overlay_cancel_btn, lv_color_hex(COLOR_BTN_PRIMARY), 0);
   lv_obj_add_event_cb(tlapse_overlay_cancel_btn, tlapse_cancel_cb, LV_EVENT_CLICKED, NULL);
   
@@ -836,9 +2213,28 @@ void create_timer_overlays() {
   lv_obj_set_style_text_color(interval_overlay_frame_counter, lv_color_hex(COLOR_TEXT_PRIMARY), 0);
   lv_obj_center(interval_overlay_frame_counter);
   
+  interval_overlay_missed_label = lv_label_create(interval_overlay);
+  lv_label_set_text(interval_overlay_missed_label, "");
+  lv_obj_set_style_text_font(interval_overlay_missed_label, &lv_font_montserrat_16, 0);
+  lv_obj_set_style_text_color(interval_overlay_missed_label, lv_color_hex(COLOR_BTN_WARNING), 0);
+  lv_obj_align(interval_overlay_missed_label, LV_ALIGN_CENTER, 0, 64);
+  
+  // Pause nur bei Interval/Sequence - show_interval_overlay() blendet sie für Burst aus
+  interval_overlay_pause_btn = lv_btn_create(interval_overlay);
+  lv_obj_set_size(interval_overlay_pause_btn, 46, 46);
+  lv_obj_align(interval_overlay_pause_btn, LV_ALIGN_BOTTOM_MID, -52, -16);
+  lv_obj_set_style_bg_color(interval_overlay_pause_btn, lv_color_hex(COLOR_BTN_SECONDARY), 0);
+  lv_obj_add_event_cb(interval_overlay_pause_btn, run_pause_cb, LV_EVENT_CLICKED, NULL);
+  
+  interval_overlay_pause_label = lv_label_create(interval_overlay_pause_btn);
+  lv_label_set_text(interval_overlay_pause_label, LV_SYMBOL_PAUSE);
+  lv_obj_set_style_text_color(interval_overlay_pause_label, lv_color_hex(COLOR_TEXT_PRIMARY), 0);
+  lv_obj_set_style_text_font(interval_overlay_pause_label, &lv_font_montserrat_20, 0);
+  lv_obj_center(interval_overlay_pause_label);
+  
   interval_overlay_cancel_btn = lv_btn_create(interval_overlay);
-  lv_obj_set_size(interval_overlay_cancel_btn, 150, 46);
-  lv_obj_align(interval_overlay_cancel_btn, LV_ALIGN_BOTTOM_MID, 0, -16);
+  lv_obj_set_size(interval_overlay_cancel_btn, 96, 46);
+  lv_obj_align(interval_overlay_cancel_btn, LV_ALIGN_BOTTOM_MID, 27, -16);
   lv_obj_set_style_bg_color(interval_overlay_cancel_btn, lv_color_hex(COLOR_BTN_PRIMARY), 0);
   lv_obj_add_event_cb(interval_overlay_cancel_btn, interval_cancel_cb, LV_EVENT_CLICKED, NULL);
   
@@ -852,6 +2248,14 @@ void create_timer_overlays() {
 }
 
 // Overlay Management
+void show_run_overlay() {
+  switch (runtime.mode) {
+    case TIMER_EXEC_MODE:  show_timer_overlay(); break;
+    case TLAPSE_EXEC_MODE: show_tlapse_overlay(); break;
+    default:               show_interval_overlay(); break;
+  }
+}
+
 void show_timer_overlay() {
   hide_timer_overlays();
   lv_obj_clear_flag(timer_overlay, LV_OBJ_FLAG_HIDDEN);
@@ -867,6 +2271,11 @@ void show_tlapse_overlay() {
 void show_interval_overlay() {
   hide_timer_overlays();
   lv_obj_clear_flag(interval_overlay, LV_OBJ_FLAG_HIDDEN);
+  if (runtime.mode == BURST_EXEC_MODE || runtime.mode == EXTERNAL_EXEC_MODE) {
+    lv_obj_add_flag(interval_overlay_pause_btn, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_clear_flag(interval_overlay_pause_btn, LV_OBJ_FLAG_HIDDEN);
+  }
   update_interval_overlay_display();
 }
 
@@ -879,10 +2288,21 @@ void hide_timer_overlays() {
 // =============================================================================
 // OVERLAY UPDATE FUNCTIONS - VEREINFACHT
 // =============================================================================
+void update_armed_overlay(lv_obj_t *time_label, lv_obj_t *info_label) {
+  // Geplanter Start: Countdown bis zum Start statt Laufzeit
+  uint32_t to_start = (uint32_t)((runtime.startTime - trigger_clock_now_us()) / 1000000);
+  lv_label_set_text(time_label, format_time_value(to_start, VALUE_FORMAT_DURATION).c_str());
+  lv_label_set_text(info_label, "Armed");
+}
+
 void update_timer_overlay_display() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedTotal = (currentTime - runtime.startTime) / 1000;
-  unsigned long elapsedPhase = (currentTime - runtime.currentPhaseStartTime) / 1000;
+  if (timer_run_armed()) {
+    update_armed_overlay(timer_overlay_time_label, timer_overlay_time_remaining_label);
+    return;
+  }
+  
+  uint64_t currentTime = trigger_clock_now_us();
+  uint32_t elapsedPhase = (uint32_t)((currentTime - runtime.currentPhaseStartTime) / 1000000);
   
   if (runtime.state == TIMER_COMPLETING) {
     // During completion - show completion message
@@ -893,35 +2313,26 @@ void update_timer_overlay_display() {
   }
   
   if (runtime.state == TIMER_DELAY_RUNNING) {
-    int remaining = runtime.totalDelayTime - elapsedPhase;
+    int remaining = runtime.totalDelayTime - (int)elapsedPhase;
     if (remaining < 0) remaining = 0;
     
-    int minutes = remaining / 60;
-    int seconds = remaining % 60;
-    String timeStr = (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
-                     (seconds < 10 ? "0" : "") + String(seconds);
+    String timeStr = format_time_value(remaining, VALUE_FORMAT_DURATION);
     
     lv_label_set_text(timer_overlay_time_label, timeStr.c_str());
     lv_obj_set_style_text_color(timer_overlay_time_label, lv_color_hex(COLOR_BTN_PRIMARY), 0);
     
-    if (runtime.totalReleaseTime > 0) {
-      int releaseMin = runtime.totalReleaseTime / 60;
-      int releaseSec = runtime.totalReleaseTime % 60;
-      String releaseStr = String("+") + (releaseMin < 10 ? "0" : "") + String(releaseMin) + ":" + 
-                         (releaseSec < 10 ? "0" : "") + String(releaseSec);
+    if (runtime.totalReleaseMs > 0) {
+      String releaseStr = "+" + format_time_value(runtime.totalReleaseMs, VALUE_FORMAT_MM_SS_T);
       lv_label_set_text(timer_overlay_time_remaining_label, releaseStr.c_str());
     } else {
       lv_label_set_text(timer_overlay_time_remaining_label, "SHOT");
     }
   } 
   else if (runtime.state == TIMER_RELEASE_RUNNING) {
-    int remaining = runtime.totalReleaseTime - elapsedPhase;
-    if (remaining < 0) remaining = 0;
-    
-    int minutes = remaining / 60;
-    int seconds = remaining % 60;
-    String timeStr = (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
-                     (seconds < 10 ? "0" : "") + String(seconds);
+    // Restzeit in ms - das Ende selbst setzt EVENT_RELEASE_END exakt
+    unsigned long elapsedMs = (unsigned long)US_TO_MS(currentTime - runtime.currentPhaseStartTime);
+    unsigned long remainingMs = elapsedMs < runtime.totalReleaseMs ? runtime.totalReleaseMs - elapsedMs : 0;
+    String timeStr = format_time_value(remainingMs, VALUE_FORMAT_MM_SS_T);
     
     lv_label_set_text(timer_overlay_time_label, timeStr.c_str());
     lv_obj_set_style_text_color(timer_overlay_time_label, lv_color_hex(0x808080), 0);
@@ -930,29 +2341,50 @@ void update_timer_overlay_display() {
 }
 
 void update_tlapse_overlay_display() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedTotal = (currentTime - runtime.startTime) / 1000;
+  if (timer_run_armed()) {
+    update_armed_overlay(tlapse_overlay_time_label, tlapse_overlay_missed_label);
+    return;
+  }
   
-  int minutes = elapsedTotal / 60;
-  int seconds = elapsedTotal % 60;
-  String timeStr = (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
-                   (seconds < 10 ? "0" : "") + String(seconds);
+  // Während der Pause steht die Laufzeit
+  uint64_t until = runtime.paused ? runtime.pausedAt : trigger_clock_now_us();
+  uint32_t elapsedTotal = (uint32_t)((until - runtime.startTime) / 1000000);
+  String timeStr = format_time_value(elapsedTotal, VALUE_FORMAT_DURATION);
   
   lv_label_set_text(tlapse_overlay_time_label, timeStr.c_str());
   lv_label_set_text(tlapse_overlay_frame_counter, String(runtime.frameCount).c_str());
+  lv_label_set_text(tlapse_overlay_pause_label, runtime.paused ? LV_SYMBOL_PLAY : LV_SYMBOL_PAUSE);
+  
+  String missedStr = runtime.paused ? "Paused" : 
+                     runtime.missedFrames > 0 ? "Missed: " + String(runtime.missedFrames) : "";
+  lv_label_set_text(tlapse_overlay_missed_label, missedStr.c_str());
 }
 
 void update_interval_overlay_display() {
-  unsigned long currentTime = millis();
-  unsigned long elapsedTotal = (currentTime - runtime.startTime) / 1000;
+  if (timer_run_armed()) {
+    update_armed_overlay(interval_overlay_time_label, interval_overlay_missed_label);
+    return;
+  }
   
-  int minutes = elapsedTotal / 60;
-  int seconds = elapsedTotal % 60;
-  String timeStr = (minutes < 10 ? "0" : "") + String(minutes) + ":" + 
-                   (seconds < 10 ? "0" : "") + String(seconds);
+  uint64_t until = runtime.paused ? runtime.pausedAt : trigger_clock_now_us();
+  uint32_t elapsedTotal = (uint32_t)((until - runtime.startTime) / 1000000);
+  String timeStr = format_time_value(elapsedTotal, VALUE_FORMAT_DURATION);
   
   lv_label_set_text(interval_overlay_time_label, timeStr.c_str());
   lv_label_set_text(interval_overlay_frame_counter, String(runtime.frameCount).c_str());
+  lv_label_set_text(interval_overlay_pause_label, runtime.paused ? LV_SYMBOL_PLAY : LV_SYMBOL_PAUSE);
+  
+  if (runtime.mode == EXTERNAL_EXEC_MODE) {
+    // Statt verpasster Frames: Latenz der letzten Auslösung
+    String latencyStr = ext_trigger.latency_count > 0 ? 
+                        "EXT " + String((unsigned long)ext_trigger.latency_last_us) + " us" : "EXT armed";
+    lv_label_set_text(interval_overlay_missed_label, latencyStr.c_str());
+    return;
+  }
+  
+  String missedStr = runtime.paused ? "Paused" : 
+                     runtime.missedFrames > 0 ? "Missed: " + String(runtime.missedFrames) : "";
+  lv_label_set_text(interval_overlay_missed_label, missedStr.c_str());
 }
 
 // =============================================================================
@@ -982,6 +2414,14 @@ void interval_cancel_cb(lv_event_t *e) {
   }
 }
 
+void run_pause_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+    // Fortsetzen nach der gespeicherten Wahl (Raster halten oder verschieben)
+    if (runtime.paused) resume_execution(app_state.resume_shift);
+    else pause_execution();
+  }
+}
+
 // =============================================================================
 // UTILITY FUNCTIONS
 // =============================================================================
@@ -1006,4 +2446,271 @@ String format_countdown_time(int totalSeconds, int elapsedSeconds, bool showBoth
   return result;
 }
 
-#endif // TIMER_SYSTEM_H
\ No newline at end of file
+void print_tlapse_plan(int frame) {
+  // Laufender Plan, sonst Plan aus den aktuellen T-Lapse-Einstellungen
+  FramePlan plan;
+  if (runtime.mode == TLAPSE_EXEC_MODE && runtime.state != TIMER_IDLE) {
+    plan = runtime.tlapsePlan;
+  } else {
+    frame_plan_init(plan, (unsigned long)get_option_value(STATE_TLAPSE, 0) * 1000, 
+                    get_option_value(STATE_TLAPSE, 1));
+  }
+  
+  if (plan.frames == 0) {
+    Serial.println("T-Lapse plan: no frames configured");
+    return;
+  }
+  
+  if (frame > 0) {
+    Serial.printf("Frame %d/%lu: +%lu ms\n", frame, (unsigned long)plan.frames, frame_plan_offset(plan, frame));
+    return;
+  }
+  
+  Serial.printf("=== T-Lapse Plan: %lu frames over %lu ms ===\n", (unsigned long)plan.frames, plan.total_ms);
+  unsigned long previous = 0;
+  for (uint32_t k = 1; k <= plan.frames; k++) {
+    unsigned long offset = frame_plan_offset(plan, k);
+    Serial.printf("Frame %lu: +%lu ms (step %lu ms)\n", (unsigned long)k, offset, offset - previous);
+    previous = offset;
+  }
+  Serial.println("==============================");
+}
+
+void print_frame_log() {
+  Serial.printf("=== Frame Log: %d fired, %d late, %d missed (policy %s) ===\n", 
+                runtime.frameCount, runtime.lateFrames, runtime.missedFrames, 
+                catchup_policy_name(app_state.catchup_policy));
+  if (runtime.paused || runtime.pausedTotal > 0) {
+    Serial.printf("Paused: %lu s total, %d frames skipped on the original grid%s\n", 
+                  (unsigned long)(runtime.pausedTotal / 1000000), runtime.pausedFrames, 
+                  runtime.paused ? " (paused now)" : "");
+  }
+  
+  uint32_t shown = frame_log_count < FRAME_LOG_SIZE ? frame_log_count : FRAME_LOG_SIZE;
+  uint8_t index = (frame_log_head + FRAME_LOG_SIZE - shown) % FRAME_LOG_SIZE;
+  for (uint32_t i = 0; i < shown; i++) {
+    const FrameRecord &record = frame_log[index];
+    if (record.status == FRAME_MISSED) {
+      Serial.printf("Frame %lu: planned +%lu ms, MISSED\n", 
+                    (unsigned long)record.slot, (unsigned long)US_TO_MS(record.planned - runtime.startTime));
+    } else {
+      Serial.printf("Frame %lu: planned +%lu ms, actual +%lu ms (%+ld ms)%s\n", 
+                    (unsigned long)record.slot, (unsigned long)US_TO_MS(record.planned - runtime.startTime), 
+                    (unsigned long)US_TO_MS(record.actual - runtime.startTime), 
+                    (long)(((int64_t)record.actual - (int64_t)record.planned) / 1000),
+                    record.status == FRAME_LATE ? " LATE" : "");
+    }
+    index = (index + 1) % FRAME_LOG_SIZE;
+  }
+  Serial.println("==============================");
+}
+
+void print_actuator_status() {
+  Serial.println("=== Actuator Channels ===");
+  uint64_t now = trigger_clock_now_us();
+  for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+    if (!output_enabled(i)) continue;
+    const ActuatorChannel &ch = actuator_channels[i];
+    unsigned long busy = actuator_busy_ms(i);
+    Serial.printf("%-8s busy %lu ms -> max %.2f frames/s%s, merged %lu\n", 
+                  ch.name, busy, busy > 0 ? 1000.0f / busy : 0.0f,
+                  time_reached(now, ch.busy_until) ? "" : " [BUSY]", (unsigned long)ch.merged);
+  }
+  Serial.printf("Min. frame interval: %lu ms\n", trigger_min_frame_interval_ms());
+  Serial.println("=========================");
+}
+
+void handle_timer_serial_commands(String command) {
+  if (command == "tlapse plan") {
+    print_tlapse_plan();
+  }
+  else if (command.startsWith("tlapse plan ")) {
+    print_tlapse_plan(command.substring(12).toInt());
+  }
+  else if (command == "frames") {
+    print_frame_log();
+  }
+  else if (command == "actuators") {
+    print_actuator_status();
+  }
+  else if (command == "pause") {
+    if (!pause_execution()) Serial.println("Pause: no running T-Lapse/Interval/Sequence");
+  }
+  else if (command == "resume" || command == "resume grid" || command == "resume shift") {
+    bool shift = command == "resume" ? app_state.resume_shift : command == "resume shift";
+    if (!resume_execution(shift)) Serial.println("Resume: run is not paused");
+  }
+  else if (command == "resume default grid" || command == "resume default shift") {
+    set_resume_shift(command.endsWith("shift"));
+  }
+  else if (command == "catchup") {
+    Serial.printf("Catch-up policy: %s\n", catchup_policy_name(app_state.catchup_policy));
+  }
+  else if (command == "catchup skip") {
+    set_catchup_policy(CATCHUP_SKIP);
+  }
+  else if (command == "catchup fire") {
+    set_catchup_policy(CATCHUP_FIRE_NOW);
+  }
+  else if (command == "catchup shift") {
+    set_catchup_policy(CATCHUP_SHIFT);
+  }
+  else if (command.startsWith("seq run ")) {
+    if (runtime.state != TIMER_IDLE) {
+      Serial.println("Sequence: another run is active - cancel it first");
+    } else if (!launch_sequence_execution(command.substring(8))) {
+      Serial.println("Sequence: not started (format e.g. D5000,B5@500*3,I0@10000)");
+    }
+  }
+  else if (command == "seq show") {
+    sequence_print(sequence_code);
+  }
+  else if (command == "ramp") {
+    // Plan aus den T-Lapse-Karten, sonst der zuletzt gesetzte
+    RampPlan plan = tlapse_ramp;
+    if (get_option_value(STATE_TLAPSE, 2) > 0) {
+      tlapse_ramp_from_options(get_option_value(STATE_TLAPSE, 0), get_option_value(STATE_TLAPSE, 1),
+                               get_option_value(STATE_TLAPSE, 2), app_state.ramp_curve, plan);
+    }
+    print_ramp_plan(plan);
+  }
+  else if (command.startsWith("ramp curve ")) {
+    int curve = ramp_curve_from_char(command.charAt(11));
+    if (curve < 0) Serial.println("Ramp: curve must be L, I, O or S");
+    else set_ramp_curve(curve);
+  }
+  else if (command.startsWith("ramp run ")) {
+    RampPlan plan;
+    plan.curve = app_state.ramp_curve;
+    if (runtime.state != TIMER_IDLE) {
+      Serial.println("Ramp: another run is active - cancel it first");
+    } else if (!ramp_parse(command.substring(9), plan) || !launch_tlapse_ramp(plan)) {
+      Serial.println("Ramp: not started (format e.g. 0@2000,1800@10000)");
+    }
+  }
+  else if (command == "focus") {
+    Serial.printf("Focus: lead %d ms, duration %d ms, every frame %s\n", 
+                  app_state.focus_lead_ms, app_state.focus_duration_ms, app_state.frame_focus ? "ON" : "OFF");
+  }
+  else if (command == "focus on" || command == "focus off") {
+    set_focus_config(command == "focus on", app_state.focus_lead_ms, app_state.focus_duration_ms);
+  }
+  else if (command.startsWith("focus lead ")) {
+    set_focus_config(app_state.frame_focus, command.substring(11).toInt(), app_state.focus_duration_ms);
+  }
+  else if (command.startsWith("focus dur ")) {
+    set_focus_config(app_state.frame_focus, app_state.focus_lead_ms, command.substring(10).toInt());
+  }
+  else if (command == "outputs") {
+    print_outputs();
+  }
+  else if (command.startsWith("output ")) {
+    // output <n> off | servo <pin> | opto <pin> [focus_pin] | time <offset_ms> <width_ms>
+    String args[4];
+    String params = command.substring(7);
+    uint8_t count = 0;
+    while (params.length() > 0 && count < 4) {
+      params.trim();
+      int space = params.indexOf(' ');
+      args[count++] = space == -1 ? params : params.substring(0, space);
+      params = space == -1 ? "" : params.substring(space + 1);
+    }
+    int channel = args[0].toInt();
+    bool ok = false;
+    if (runtime.state != TIMER_IDLE) {
+      Serial.println("Outputs: cannot reconfigure while a run is active");
+      return;
+    }
+    if (channel >= 0 && channel < OUTPUT_MAX_CHANNELS) {
+      const OutputChannelConfig &ch = output_store.channels[channel];
+      if (args[1] == "time") {
+        ok = count >= 4 && output_configure(channel, output_type_char(ch.type), ch.pin, ch.focus_pin,
+                                            args[2].toInt(), args[3].toInt());
+      } else if (args[1] == "off" || args[1] == "servo" || args[1] == "opto") {
+        // Hauptkanäle (0/1) haben feste Pins - Pin-Angabe dort optional
+        int pin = count >= 3 ? args[2].toInt() : ch.pin;
+        int focus = count >= 4 ? args[3].toInt() : (channel < 2 ? ch.focus_pin : -1);
+        ok = output_configure(channel, args[1] == "off" ? '-' : toupper(args[1][0]), pin, focus,
+                              ch.offset_ms, ch.width_ms);
+      }
+    }
+    if (ok) {
+      print_outputs();
+    } else {
+      Serial.printf("Outputs: usage output <0-%d> off|servo <pin>|opto <pin> [focus]|time <0-%d ms> <%d-%d ms>\n",
+                    OUTPUT_MAX_CHANNELS - 1, OUTPUT_MAX_OFFSET_MS, OUTPUT_MIN_WIDTH_MS, OUTPUT_MAX_WIDTH_MS);
+    }
+  }
+  else if (command == "lag") {
+    print_lag_profiles();
+  }
+  else if (command.startsWith("lag use ")) {
+    if (!lag_profile_select(command.substring(8).toInt())) Serial.println("Lag: invalid profile");
+  }
+  else if (command.startsWith("lag set ")) {
+    // lag set <i> <ms> [name]
+    String params = command.substring(8);
+    int first = params.indexOf(' ');
+    int second = params.indexOf(' ', first + 1);
+    String name = second == -1 ? "" : params.substring(second + 1);
+    int lag = params.substring(first + 1, second == -1 ? params.length() : second).toInt();
+    if (first == -1 || !lag_profile_set(params.substring(0, first).toInt(), name, lag)) {
+      Serial.printf("Lag: usage lag set <0-%d> <0-%d ms> [name]\n", LAG_PROFILE_COUNT - 1, LAG_MAX_MS);
+    }
+  }
+  else if (command == "lag measure") {
+    if (!lag_measure_start()) Serial.println("Lag: measurement not possible while a run is active");
+  }
+  else if (command == "ext") {
+    print_ext_trigger_status();
+  }
+  else if (command == "ext arm") {
+    if (runtime.state != TIMER_IDLE) {
+      Serial.println("External trigger: another run is active - cancel it first");
+    } else if (!launch_external_trigger()) {
+      Serial.println("External trigger: not armed");
+    }
+  }
+  else if (command == "ext fire") {
+    if (!ext_trigger_simulate()) Serial.println("External trigger: not armed, locked out or busy");
+  }
+  else if (command.startsWith("ext delay ") || command.startsWith("ext lockout ")) {
+    bool delay = command.startsWith("ext delay ");
+    int value = command.substring(delay ? 10 : 12).toInt();
+    int delay_ms = delay ? value : app_state.ext_delay_ms;
+    int lockout_ms = delay ? app_state.ext_lockout_ms : value;
+    if (!ext_trigger_config_valid(delay_ms, lockout_ms)) {
+      Serial.printf("External trigger: delay 0-%d ms, lockout 0-%d ms\n", 
+                    EXT_TRIGGER_MAX_DELAY_MS, EXT_TRIGGER_MAX_LOCKOUT_MS);
+    } else {
+      set_ext_trigger_config(delay_ms, lockout_ms, app_state.ext_servo);
+    }
+  }
+  else if (command == "ext servo on" || command == "ext servo off") {
+    set_ext_trigger_config(app_state.ext_delay_ms, app_state.ext_lockout_ms, command == "ext servo on");
+  }
+  else if (command == "burst") {
+    if (runtime.state != TIMER_IDLE) {
+      Serial.println("Burst: another run is active - cancel it first");
+    } else {
+      start_burst_execution();
+    }
+  }
+  else if (command.startsWith("burst set ")) {
+    // burst set <count> <hz> <pulse_ms>
+    String params = command.substring(10);
+    int first = params.indexOf(' ');
+    int second = params.indexOf(' ', first + 1);
+    int count = params.substring(0, first).toInt();
+    int rate = params.substring(first + 1, second).toInt();
+    int pulse = params.substring(second + 1).toInt();
+    if (first == -1 || second == -1 || !burst_config_valid(count, rate, pulse)) {
+      Serial.printf("Burst: invalid (1-%d pulses, 1-%d Hz, pulse >= %d ms, pulse + %d ms <= period)\n", 
+                    BURST_MAX_COUNT, BURST_MAX_RATE_HZ, BURST_MIN_PULSE_MS, BURST_MIN_GAP_MS);
+    } else {
+      set_burst_config(count, rate, pulse);
+    }
+  }
+}
+
+#endif // TIMER_SYSTEM_H
@@ -0,0 +1,247 @@
+/*
+=============================================================================
+trigger_clock.h - One-Shot Clock Backend für den Trigger-Scheduler
+=============================================================================
+Auf dem ESP32 weckt ein esp_timer One-Shot den Dispatcher genau zur nächsten
+Deadline - unabhängig davon, ob app_loop() gerade in lv_timer_handler(),
+Serial-Ausgaben, NVS-Writes oder delay() hängt.
+Ohne ESP32 (oder mit TRIGGER_CLOCK_HOST) läuft eine Host-Uhr, die manuell
+vorgestellt wird und den Callback synchron auslöst. Dieser Pfad braucht
+kein Arduino-Framework - tests/host_scheduler_test.cpp baut ihn mit g++.
+Zeitbasis: monotone 64-Bit-Mikrosekunden ab Boot - kein Überlauf wie bei
+millis() nach 49,7 Tagen, Deadlines lassen sich direkt mit < vergleichen.
+=============================================================================
+*/
+
+#ifndef TRIGGER_CLOCK_H
+#define TRIGGER_CLOCK_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+#include "config.h"
+#include <sys/time.h>
+
+#if defined(ESP32) && !defined(TRIGGER_CLOCK_HOST)
+#define TRIGGER_CLOCK_HARDWARE 1
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#else
+#define TRIGGER_CLOCK_HARDWARE 0
+#endif
+
+typedef void (*trigger_clock_callback_t)();
+
+// Umrechnung für Dauern (ms) auf der µs-Zeitbasis
+#define MS_TO_US(ms)  ((uint64_t)(ms) * 1000ULL)
+#define US_TO_MS(us)  ((uint64_t)(us) / 1000ULL)
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void trigger_clock_init(trigger_clock_callback_t callback);
+uint64_t trigger_clock_now_us();                    // Monoton, µs seit Boot
+void trigger_clock_continue_from(uint64_t now_us);  // Zeitbasis nach Deep-Sleep/Reset fortsetzen
+uint64_t trigger_clock_rtc_us();                    // RTC-Zeit, läuft über Deep-Sleep und Soft-Resets weiter
+void trigger_clock_arm(uint64_t deadline_us);       // One-Shot auf absolute Deadline
+void trigger_clock_disarm();
+
+// Schützt Scheduler + Runtime zwischen Loop und Timer-Callback
+void trigger_clock_lock();
+void trigger_clock_unlock();
+bool trigger_clock_in_callback();                   // true im Dispatch-Kontext (esp_timer- oder Flanken-Task)
+
+// Drift einer Uhr gegen eine Referenz in ppb (Wall Clock: RTC, Time Sync: Master)
+int64_t drift_us(int64_t span_us, int32_t ppb);           // span * ppb / 1e9
+int64_t drift_inverse_us(int64_t span_us, int32_t ppb);   // span / (1 + ppb / 1e9)
+bool drift_plausible(int64_t delta_us, int64_t span_us, uint32_t max_ppm);   // |delta| <= span * max_ppm
+int32_t drift_measure_ppb(int64_t delta_us, int64_t span_us);                // Nur nach drift_plausible()
+
+#if TRIGGER_CLOCK_HARDWARE
+void trigger_clock_register_edge_task(TaskHandle_t task);   // Weiterer Task mit Dispatch-Regeln (kein Serial)
+#endif
+
+#if !TRIGGER_CLOCK_HARDWARE
+void trigger_clock_host_set(uint64_t now_us);
+void trigger_clock_host_advance(uint64_t delta_us);
+#endif
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+trigger_clock_callback_t trigger_clock_callback = nullptr;
+
+int64_t drift_us(int64_t span_us, int32_t ppb) {
+  // In Sekunden und Rest aufgeteilt, damit auch Tage nicht überlaufen
+  return (span_us / 1000000) * ppb / 1000 + (span_us % 1000000) * ppb / 1000000000;
+}
+
+int64_t drift_inverse_us(int64_t span_us, int32_t ppb) {
+  // Bis zum Glied zweiter Ordnung
+  int64_t drift = drift_us(span_us, ppb);
+  return span_us - drift + drift_us(drift, ppb);
+}
+
+bool drift_plausible(int64_t delta_us, int64_t span_us, uint32_t max_ppm) {
+  // Ohne Multiplikation mit 1e9 - ein Sprung um Stunden darf nicht überlaufen
+  if (span_us <= 0) return false;
+  uint64_t magnitude = delta_us < 0 ? 0 - (uint64_t)delta_us : (uint64_t)delta_us;
+  return magnitude <= (uint64_t)(span_us / 1000000) * max_ppm;
+}
+
+int32_t drift_measure_ppb(int64_t delta_us, int64_t span_us) {
+  // delta * 1e9 / span, über ms gerechnet: |delta| <= span_s * max_ppm hält delta * 1e6 im Bereich
+  return (int32_t)(delta_us * 1000000 / (span_us / 1000));
+}
+
+uint64_t trigger_clock_rtc_us() {
+  // Systemzeit läuft auf dem RTC-Timer - nur ein Power-On-Reset setzt sie zurück
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (uint64_t)tv.tv_sec * 1000000ULL + tv.tv_usec;
+}
+
+#if TRIGGER_CLOCK_HARDWARE
+// -----------------------------------------------------------------------------
+// ESP32: esp_timer One-Shot (Dispatch im esp_timer-Task, hohe Priorität)
+// -----------------------------------------------------------------------------
+esp_timer_handle_t trigger_clock_timer = nullptr;
+SemaphoreHandle_t trigger_clock_mutex = nullptr;
+int64_t trigger_clock_epoch_us = 0;   // Versatz zu esp_timer_get_time() (0 bis zum ersten Resume)
+
+// Kontext am Task festmachen statt an einem globalen Flag - Loop und Control-Task
+// laufen parallel zum Dispatch und dürfen weiter loggen
+TaskHandle_t trigger_clock_dispatch_task = nullptr;   // esp_timer-Task, beim ersten Callback gemerkt
+TaskHandle_t trigger_clock_edge_task = nullptr;
+
+bool trigger_clock_in_callback() {
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  return current == trigger_clock_dispatch_task || 
+         (trigger_clock_edge_task && current == trigger_clock_edge_task);
+}
+
+void trigger_clock_register_edge_task(TaskHandle_t task) {
+  trigger_clock_edge_task = task;
+}
+
+void trigger_clock_timer_cb(void *arg) {
+  if (!trigger_clock_callback) return;
+  if (!trigger_clock_dispatch_task) trigger_clock_dispatch_task = xTaskGetCurrentTaskHandle();
+  trigger_clock_callback();
+}
+
+void trigger_clock_init(trigger_clock_callback_t callback) {
+  trigger_clock_callback = callback;
+
+  // Rekursiv, damit verschachtelte Aufrufe aus Loop-Kontext nicht blockieren
+  trigger_clock_mutex = xSemaphoreCreateRecursiveMutex();
+
+  esp_timer_create_args_t args = {};
+  args.callback = trigger_clock_timer_cb;
+  args.arg = nullptr;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "trigger_clock";
+
+  if (esp_timer_create(&args, &trigger_clock_timer) != ESP_OK) {
+    trigger_clock_timer = nullptr;
+    DEBUG_PRINTLN("ERROR: Trigger clock timer could not be created - loop dispatch only");
+    return;
+  }
+  DEBUG_PRINTLN("Trigger clock initialized (esp_timer one-shot)");
+}
+
+uint64_t trigger_clock_now_us() {
+  return (uint64_t)(esp_timer_get_time() + trigger_clock_epoch_us);
+}
+
+void trigger_clock_continue_from(uint64_t now_us) {
+  // esp_timer beginnt nach jedem Boot bei 0 - gespeicherte Deadlines bleiben so gültig
+  trigger_clock_epoch_us = (int64_t)now_us - esp_timer_get_time();
+}
+
+void trigger_clock_arm(uint64_t deadline_us) {
+  if (!trigger_clock_timer) return;
+
+  uint64_t now_us = trigger_clock_now_us();
+  uint64_t delay_us = (deadline_us > now_us) ? deadline_us - now_us : 1;
+
+  esp_timer_stop(trigger_clock_timer);   // Fehler wenn nicht aktiv - egal
+  esp_timer_start_once(trigger_clock_timer, delay_us);
+}
+
+void trigger_clock_disarm() {
+  if (trigger_clock_timer) esp_timer_stop(trigger_clock_timer);
+}
+
+void trigger_clock_lock() {
+  if (trigger_clock_mutex) xSemaphoreTakeRecursive(trigger_clock_mutex, portMAX_DELAY);
+}
+
+void trigger_clock_unlock() {
+  if (trigger_clock_mutex) xSemaphoreGiveRecursive(trigger_clock_mutex);
+}
+
+#else
+// -----------------------------------------------------------------------------
+// HOST: manuell gesteuerte Uhr, Callback läuft synchron in advance()
+// -----------------------------------------------------------------------------
+uint64_t trigger_clock_host_now = 0;
+uint64_t trigger_clock_host_deadline = 0;
+bool trigger_clock_host_armed = false;
+bool trigger_clock_callback_running = false;   // Host ist single-threaded - Flag reicht
+
+bool trigger_clock_in_callback() {
+  return trigger_clock_callback_running;
+}
+
+void trigger_clock_init(trigger_clock_callback_t callback) {
+  trigger_clock_callback = callback;
+  trigger_clock_host_armed = false;
+  DEBUG_PRINTLN("Trigger clock initialized (host clock)");
+}
+
+uint64_t trigger_clock_now_us() {
+  return trigger_clock_host_now;
+}
+
+void trigger_clock_continue_from(uint64_t now_us) {
+  trigger_clock_host_now = now_us;
+}
+
+void trigger_clock_arm(uint64_t deadline_us) {
+  trigger_clock_host_deadline = deadline_us;
+  trigger_clock_host_armed = true;
+}
+
+void trigger_clock_disarm() {
+  trigger_clock_host_armed = false;
+}
+
+void trigger_clock_lock() {}
+void trigger_clock_unlock() {}
+
+void trigger_clock_host_set(uint64_t now_us) {
+  trigger_clock_host_now = now_us;
+
+  // Der Callback darf neu armieren - so lange feuern, bis nichts mehr fällig ist
+  while (trigger_clock_host_armed &&
+         trigger_clock_host_now >= trigger_clock_host_deadline) {
+    trigger_clock_host_armed = false;
+    if (!trigger_clock_callback) break;
+    trigger_clock_callback_running = true;
+    trigger_clock_callback();
+    trigger_clock_callback_running = false;
+  }
+}
+
+void trigger_clock_host_advance(uint64_t delta_us) {
+  trigger_clock_host_set(trigger_clock_host_now + delta_us);
+}
+#endif
+
+#endif // TRIGGER_CLOCK_H
@@ -123,12 +123,12 @@ bool main_is_animating = false;
 lv_obj_t *template_page;
 lv_obj_t *template_header_label;
 lv_obj_t *template_button_container;
-lv_obj_t *template_option1_btn, *template_option2_btn;
-lv_obj_t *template_option1_label, *template_option2_label;
-lv_obj_t *template_option1_time, *template_option2_time;
+lv_obj_t *template_option1_btn, *template_option2_btn, *template_option3_btn;
+lv_obj_t *template_option1_label, *template_option2_label, *template_option3_label;
+lv_obj_t *template_option1_time, *template_option2_time, *template_option3_time;
 lv_obj_t *template_swipe_area;
 lv_obj_t *template_start_btn;
-lv_obj_t *template_dot1, *template_dot2;
+lv_obj_t *template_dot1, *template_dot2, *template_dot3;   // Dritte Karte nur bei T-Lapse (Ramp)
 
 // Interval page objects (nur 1 Karte)
 lv_obj_t *interval_page;
@@ -149,6 +149,7 @@ lv_obj_t *settings_battery_widget;
 lv_obj_t *settings_wire_btn;
 lv_obj_t *settings_led_switch;
 lv_obj_t *settings_bt_switch;
+lv_obj_t *settings_burst_btn;
 
 // Wire settings page objects  
 lv_obj_t *wire_settings_page;
@@ -196,6 +197,7 @@ lv_obj_t* create_main_card(lv_obj_t *parent, MainCard card_data, int initial_x);
 
 // Template page swipe functionality
 void update_template_dots(int active_index);
+void layout_template_dots(int count);
 void animate_to_option(int target_option);
 void anim_complete_cb(lv_anim_t *a);
 
@@ -219,6 +221,7 @@ void settings_back_cb(lv_event_t *e);
 void settings_wire_cb(lv_event_t *e);
 void settings_led_switch_cb(lv_event_t *e);
 void settings_bt_switch_cb(lv_event_t *e);
+void settings_burst_cb(lv_event_t *e);
 void wire_settings_back_cb(lv_event_t *e);
 void wire_save_cb(lv_event_t *e);
 
@@ -361,6 +364,7 @@ void recreate_bt_indicators_for_current_page() {
       
     case STATE_TIMER:
     case STATE_TLAPSE:
+    case STATE_BURST:   // Burst nutzt die T-Lapse-Position (gleiches Template)
       if (template_page) {
         lv_obj_t *header = lv_obj_get_child(template_page, 0);
         if (header) {
@@ -755,12 +759,24 @@ void create_main_page() {
 }
 
 void update_template_dots(int active_index) {
-  if (active_index == 0) {
-    lv_obj_set_style_bg_color(template_dot1, lv_color_hex(COLOR_DOT_ACTIVE), 0);
-    lv_obj_set_style_bg_color(template_dot2, lv_color_hex(COLOR_DOT_INACTIVE), 0);
+  lv_obj_t *dots[] = {template_dot1, template_dot2, template_dot3};
+  for (int i = 0; i < 3; i++) {
+    lv_obj_set_style_bg_color(dots[i], lv_color_hex(i == active_index ? COLOR_DOT_ACTIVE : COLOR_DOT_INACTIVE), 0);
+  }
+}
+
+void layout_template_dots(int count) {
+  // Punkte im 60 px breiten Container zentriert, dritter nur bei T-Lapse
+  int first_x = (count == 3) ? 14 : 20;
+  lv_obj_set_pos(template_dot1, first_x, 6);
+  lv_obj_set_pos(template_dot2, first_x + 12, 6);
+  lv_obj_set_pos(template_dot3, first_x + 24, 6);
+  if (count == 3) {
+    lv_obj_clear_flag(template_option3_btn, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(template_dot3, LV_OBJ_FLAG_HIDDEN);
   } else {
-    lv_obj_set_style_bg_color(template_dot1, lv_color_hex(COLOR_DOT_INACTIVE), 0);
-    lv_obj_set_style_bg_color(template_dot2, lv_color_hex(COLOR_DOT_ACTIVE), 0);
+    lv_obj_add_flag(template_option3_btn, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(template_dot3, LV_OBJ_FLAG_HIDDEN);
   }
 }
 
@@ -780,29 +796,21 @@ void animate_to_option(int target_option) {
   app_state.is_animating = true;
   app_state.current_option = target_option;
   
-  int btn1_target_x = (target_option == 0) ? 5 : -145;
-  int btn2_target_x = (target_option == 0) ? 155 : 5;
-  
   DEBUG_PRINTF("Animating to option %d (Timer/T-Lapse only)\n", target_option);
   
-  lv_anim_t anim1;
-  lv_anim_init(&anim1);
-  lv_anim_set_var(&anim1, template_option1_btn);
-  lv_anim_set_values(&anim1, lv_obj_get_x(template_option1_btn), btn1_target_x);
-  lv_anim_set_time(&anim1, ANIMATION_TIME_MS);
-  lv_anim_set_exec_cb(&anim1, (lv_anim_exec_xcb_t)lv_obj_set_x);
-  lv_anim_set_path_cb(&anim1, lv_anim_path_ease_out);
-  lv_anim_start(&anim1);
-  
-  lv_anim_t anim2;
-  lv_anim_init(&anim2);
-  lv_anim_set_var(&anim2, template_option2_btn);
-  lv_anim_set_values(&anim2, lv_obj_get_x(template_option2_btn), btn2_target_x);
-  lv_anim_set_time(&anim2, ANIMATION_TIME_MS);
-  lv_anim_set_exec_cb(&anim2, (lv_anim_exec_xcb_t)lv_obj_set_x);
-  lv_anim_set_path_cb(&anim2, lv_anim_path_ease_out);
-  lv_anim_set_ready_cb(&anim2, anim_complete_cb);
-  lv_anim_start(&anim2);
+  // Aktive Karte bei x=5, die anderen im 150er Raster daneben
+  lv_obj_t *cards[] = {template_option1_btn, template_option2_btn, template_option3_btn};
+  for (int i = 0; i < 3; i++) {
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, cards[i]);
+    lv_anim_set_values(&anim, lv_obj_get_x(cards[i]), 5 + (i - target_option) * 150);
+    lv_anim_set_time(&anim, ANIMATION_TIME_MS);
+    lv_anim_set_exec_cb(&anim, (lv_anim_exec_xcb_t)lv_obj_set_x);
+    lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
+    if (i == 2) lv_anim_set_ready_cb(&anim, anim_complete_cb);
+    lv_anim_start(&anim);
+  }
 }
 
 static lv_coord_t start_x = 0;
@@ -830,11 +838,11 @@ void template_swipe_cb(lv_event_t *e) {
     lv_coord_t diff = end_x - start_x;
     
     if (abs(diff) > SWIPE_THRESHOLD) {
-      if (diff > 0 && app_state.current_option == 1) {
-        animate_to_option(0);
+      if (diff > 0 && app_state.current_option > 0) {
+        animate_to_option(app_state.current_option - 1);
       }
-      else if (diff < 0 && app_state.current_option == 0) {
-        animate_to_option(1);
+      else if (diff < 0 && app_state.current_option < page_option_count(app_state.current_state) - 1) {
+        animate_to_option(app_state.current_option + 1);
       }
     }
     
@@ -912,6 +920,32 @@ void create_template_page() {
   lv_obj_set_style_text_font(template_option2_time, &lv_font_montserrat_40, 0);
   lv_obj_align(template_option2_time, LV_ALIGN_TOP_MID, 0, 60);
 
+  // Dritte Karte - T-Lapse Ramp (Endabstand)
+  template_option3_btn = lv_btn_create(template_button_container);
+  lv_obj_set_size(template_option3_btn, 142, 146);
+  lv_obj_set_pos(template_option3_btn, 305, 10);
+  lv_obj_set_style_bg_color(template_option3_btn, lv_color_hex(COLOR_BTN_SECONDARY), 0);
+  lv_obj_set_style_radius(template_option3_btn, 8, 0);
+  lv_obj_clear_flag(template_option3_btn, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_add_flag(template_option3_btn, LV_OBJ_FLAG_HIDDEN);
+
+  lv_obj_t *option3_container = lv_obj_create(template_option3_btn);
+  lv_obj_set_size(option3_container, lv_pct(100), lv_pct(100));
+  lv_obj_center(option3_container);
+  lv_obj_set_style_bg_opa(option3_container, LV_OPA_TRANSP, 0);
+  lv_obj_set_style_border_width(option3_container, 0, 0);
+  lv_obj_clear_flag(option3_container, LV_OBJ_FLAG_SCROLLABLE);
+
+  template_option3_label = lv_label_create(option3_container);
+  lv_label_set_text(template_option3_label, "Option 3");
+  lv_obj_set_style_text_font(template_option3_label, &lv_font_montserrat_28, 0);
+  lv_obj_align(template_option3_label, LV_ALIGN_TOP_LEFT, -10, 0);
+
+  template_option3_time = lv_label_create(option3_container);
+  lv_label_set_text(template_option3_time, "OFF");
+  lv_obj_set_style_text_font(template_option3_time, &lv_font_montserrat_40, 0);
+  lv_obj_align(template_option3_time, LV_ALIGN_TOP_MID, 0, 60);
+
   template_swipe_area = lv_obj_create(template_page);
   lv_obj_set_size(template_swipe_area, lv_pct(90), 60);
   lv_obj_align(template_swipe_area, LV_ALIGN_CENTER, 0, 65);
@@ -941,6 +975,14 @@ void create_template_page() {
   lv_obj_set_style_border_width(template_dot2, 0, 0);
   lv_obj_set_style_radius(template_dot2, 4, 0);
 
+  template_dot3 = lv_obj_create(dots_container);
+  lv_obj_set_size(template_dot3, 8, 8);
+  lv_obj_set_pos(template_dot3, 44, 6);
+  lv_obj_set_style_bg_color(template_dot3, lv_color_hex(COLOR_DOT_INACTIVE), 0);
+  lv_obj_set_style_border_width(template_dot3, 0, 0);
+  lv_obj_set_style_radius(template_dot3, 4, 0);
+  lv_obj_add_flag(template_dot3, LV_OBJ_FLAG_HIDDEN);
+
   template_start_btn = lv_btn_create(template_page);
   lv_obj_set_size(template_start_btn, 150, 46);
   lv_obj_align(template_start_btn, LV_ALIGN_BOTTOM_MID, 0, -16);
@@ -1121,6 +1163,20 @@ void create_settings_page() {
   if (app_state.bluetooth_enabled) {
     lv_obj_add_state(settings_bt_switch, LV_STATE_CHECKED);
   }
+
+  // Burst Button - öffnet den Burst-Editor (Count/Rate/Pulse, Start feuert)
+  settings_burst_btn = lv_btn_create(settings_page);
+  lv_obj_set_size(settings_burst_btn, 150, 46);
+  lv_obj_align(settings_burst_btn, LV_ALIGN_TOP_MID, 0, 260);
+  lv_obj_set_style_bg_color(settings_burst_btn, lv_color_hex(COLOR_BTN_PRIMARY), 0);
+  lv_obj_set_style_radius(settings_burst_btn, 8, 0);
+  lv_obj_add_event_cb(settings_burst_btn, settings_burst_cb, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *burst_label = lv_label_create(settings_burst_btn);
+  lv_label_set_text(burst_label, "Burst");
+  lv_obj_set_style_text_color(burst_label, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
+  lv_obj_set_style_text_font(burst_label, &lv_font_montserrat_20, 0);
+  lv_obj_center(burst_label);
 }
 
 void create_wire_settings_page() {
@@ -1238,6 +1294,9 @@ void template_start_cb(lv_event_t *e) {
       case STATE_TLAPSE:
         start_tlapse_execution();
         break;
+      case STATE_BURST:
+        start_burst_execution();
+        break;
       default:
         DEBUG_PRINTLN("Invalid state for timer start");
         break;
@@ -1311,6 +1370,14 @@ void settings_bt_switch_cb(lv_event_t *e) {
   }
 }
 
+void settings_burst_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+    DEBUG_PRINTLN("Burst button pressed");
+    change_state(STATE_BURST);
+    show_current_page();
+  }
+}
+
 void wire_settings_back_cb(lv_event_t *e) {
   if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
     DEBUG_PRINTLN("Wire settings back pressed");
@@ -1344,6 +1411,8 @@ void update_template_content(PageContent content) {
   lv_label_set_text(template_option2_label, content.option2_text.c_str());
   lv_label_set_text(template_option1_time, content.option1_time.c_str());
   lv_label_set_text(template_option2_time, content.option2_time.c_str());
+  lv_label_set_text(template_option3_label, content.option3_text.c_str());
+  lv_label_set_text(template_option3_time, content.option3_time.c_str());
   
   // Update dots to reflect current state
   update_template_dots(app_state.current_option);
@@ -1357,11 +1426,15 @@ void init_template_content(PageContent content) {
   lv_label_set_text(template_option2_label, content.option2_text.c_str());
   lv_label_set_text(template_option1_time, content.option1_time.c_str());
   lv_label_set_text(template_option2_time, content.option2_time.c_str());
+  lv_label_set_text(template_option3_label, content.option3_text.c_str());
+  lv_label_set_text(template_option3_time, content.option3_time.c_str());
   
   // Reset to first option when initially showing page
   app_state.current_option = 0;
   lv_obj_set_pos(template_option1_btn, 5, 10);
   lv_obj_set_pos(template_option2_btn, 155, 10);
+  lv_obj_set_pos(template_option3_btn, 305, 10);
+  layout_template_dots(page_option_count(app_state.current_state));
   update_template_dots(0);
   
   DEBUG_PRINTLN("Template page initialized - reset to option 0");
@@ -1402,6 +1475,13 @@ void show_current_page() {
       DEBUG_PRINTLN("Showing time-lapse template");
       break;
      
+    case STATE_BURST:
+      burst_values_from_state();   // BLE/Serial können die Werte geändert haben
+      init_template_content(burst_content);
+      lv_obj_clear_flag(template_page, LV_OBJ_FLAG_HIDDEN);
+      DEBUG_PRINTLN("Showing burst template");
+      break;
+     
     case STATE_INTERVAL:
       app_state.current_option = 0;
       update_interval_content(interval_content);
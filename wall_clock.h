@@ -0,0 +1,245 @@
+/*
+=============================================================================
+wall_clock.h - Uhrzeit + geplanter Start zu einer Tageszeit
+=============================================================================
+Die Uhrzeit kommt von außen (BLE "CLOCK:" vom Handy, Serial "clock set") und
+wird als Referenzpunkt gegen die RTC-Zeit gespeichert - die Systemzeit
+(settimeofday) bleibt unangetastet, weil Deep-Sleep und Checkpoints mit
+RTC-Differenzen rechnen.
+Im Deep-Sleep läuft die RTC auf dem langsamen RC-Takt und driftet einige
+hundert ppm. Liegen zwei Syncs mindestens WALLCLOCK_MIN_CAL_S auseinander,
+ergibt ihr Vergleich die Drift - sie wird im NVS gehalten (Eigenschaft des
+Chips) und sowohl beim Ablesen der Uhrzeit als auch beim Umrechnen eines
+Startzeitpunkts auf die Trigger-Zeitbasis berücksichtigt.
+Ein geplanter Start ist ein normaler Lauf, dessen startTime in der Zukunft
+liegt: Deep-Sleep, Light-Sleep und Checkpoints funktionieren unverändert.
+=============================================================================
+*/
+
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stddef.h>
+#include <time.h>
+#include "config.h"
+#include "trigger_clock.h"
+#include "checksum.h"
+
+#if defined(ESP32)
+#include "esp_system.h"
+#endif
+
+// =============================================================================
+// WALL CLOCK STATE
+// =============================================================================
+#define WALLCLOCK_NAMESPACE   "wallclock"
+#define WALLCLOCK_MAGIC       0x52535743   // "RSWC"
+
+// Referenzpunkt: epoch_us (UTC) entsprach rtc_us. cal_* ist der Anker der
+// Drift-Messung - er wandert erst weiter, wenn eine Messung gelungen ist
+struct WallClockSync {
+  uint32_t magic;
+  uint32_t checksum;          // FNV-1a ab epoch_us
+  int64_t epoch_us;
+  uint64_t rtc_us;
+  int64_t cal_epoch_us;
+  uint64_t cal_rtc_us;
+  int32_t tz_offset_s;        // Lokalzeit = UTC + Offset
+};
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+void wall_clock_init();
+bool wall_clock_valid();
+void wall_clock_set(int64_t epoch_us, int32_t tz_offset_s);
+int64_t wall_clock_now_us();                        // UTC, µs seit 1970 (0 = nicht gestellt)
+int64_t wall_clock_drift_us(int64_t span_us);       // Drift der RTC über span_us
+String wall_clock_format(int64_t epoch_us);         // Lokalzeit "YYYY-MM-DD HH:MM:SS"
+String wall_clock_status_string();                  // BLE: <epoch_ms>:<tz_min>:<drift_ppb>:<calibrated>
+void print_wall_clock_status();
+
+// Geplanter Start
+bool wall_clock_next_time_of_day(uint32_t seconds_of_day, int64_t &epoch_us);
+bool wall_clock_start_at(int64_t epoch_us, TimerExecutionMode mode);   // false = Uhr nicht gestellt/belegt
+bool wall_clock_parse_time_of_day(String text, uint32_t &seconds_of_day);  // "HH:MM[:SS]"
+
+// =============================================================================
+// IMPLEMENTATION
+// =============================================================================
+RTC_NOINIT_ATTR WallClockSync wall_clock_sync;     // Überlebt Deep-Sleep und Soft-Resets wie die RTC-Zeit
+int32_t wall_clock_drift_ppb = 0;                  // > 0: RTC läuft so viel zu schnell
+bool wall_clock_calibrated = false;
+
+uint32_t wall_clock_checksum() {
+  return fnv1a(&wall_clock_sync.epoch_us, sizeof(wall_clock_sync) - offsetof(WallClockSync, epoch_us));
+}
+
+void wall_clock_init() {
+#if defined(ESP32)
+  if (esp_reset_reason() == ESP_RST_POWERON) {
+    // RTC-Zeit beginnt wieder bei 0 - der alte Referenzpunkt passt nicht mehr
+    wall_clock_sync.magic = 0;
+  }
+#endif
+  if (wall_clock_sync.magic == WALLCLOCK_MAGIC && wall_clock_sync.checksum != wall_clock_checksum()) {
+    wall_clock_sync.magic = 0;
+  }
+
+  Preferences prefs;
+  if (prefs.begin(WALLCLOCK_NAMESPACE, true)) {
+    wall_clock_calibrated = prefs.isKey("drift_ppb");
+    wall_clock_drift_ppb = prefs.getInt("drift_ppb", 0);
+    prefs.end();
+  }
+
+  DEBUG_PRINTF("Wall clock: %s, RTC drift %s%ld ppb\n",
+               wall_clock_valid() ? wall_clock_format(wall_clock_now_us()).c_str() : "not set",
+               wall_clock_calibrated ? "" : "uncalibrated ", (long)wall_clock_drift_ppb);
+}
+
+bool wall_clock_valid() {
+  return wall_clock_sync.magic == WALLCLOCK_MAGIC;
+}
+
+int64_t wall_clock_drift_us(int64_t span_us) {
+  return drift_us(span_us, wall_clock_drift_ppb);
+}
+
+int64_t wall_clock_now_us() {
+  if (!wall_clock_valid()) return 0;
+  int64_t rtc_span = (int64_t)(trigger_clock_rtc_us() - wall_clock_sync.rtc_us);
+  // RTC-Spanne -> echte Spanne
+  return wall_clock_sync.epoch_us + drift_inverse_us(rtc_span, wall_clock_drift_ppb);
+}
+
+void wall_clock_set(int64_t epoch_us, int32_t tz_offset_s) {
+  uint64_t rtc_now = trigger_clock_rtc_us();
+
+  if (wall_clock_valid()) {
+    int64_t error_us = wall_clock_now_us() - epoch_us;
+    int64_t ref_span = epoch_us - wall_clock_sync.cal_epoch_us;
+    int64_t rtc_span = (int64_t)(rtc_now - wall_clock_sync.cal_rtc_us);
+    DEBUG_PRINTF("Wall clock: was %ld ms off after %lu s\n", (long)(error_us / 1000),
+                 (unsigned long)((epoch_us - wall_clock_sync.epoch_us) / 1000000));
+
+    if (ref_span >= (int64_t)WALLCLOCK_MIN_CAL_S * 1000000) {
+      // Gesamtrate über die ganze Spanne - unabhängig von der bisherigen Korrektur
+      int64_t delta = rtc_span - ref_span;
+      if (!drift_plausible(delta, ref_span, WALLCLOCK_MAX_DRIFT_PPM)) {
+        // Falsche Uhrzeit gesendet oder Uhr verstellt - nicht ins NVS, Messung beginnt neu
+        DEBUG_PRINTF("Wall clock: %ld s jump over %lu s is no RTC drift - calibration kept at %ld ppb\n",
+                     (long)(delta / 1000000), (unsigned long)(ref_span / 1000000), (long)wall_clock_drift_ppb);
+      } else {
+        int32_t measured = drift_measure_ppb(delta, ref_span);
+        wall_clock_drift_ppb = wall_clock_calibrated ?
+                               (int32_t)(((int64_t)wall_clock_drift_ppb + (int64_t)measured * 3) / 4) : measured;
+        wall_clock_calibrated = true;
+
+        Preferences prefs;
+        if (prefs.begin(WALLCLOCK_NAMESPACE, false)) {
+          prefs.putInt("drift_ppb", wall_clock_drift_ppb);
+          prefs.end();
+        }
+        DEBUG_PRINTF("Wall clock: RTC drift measured %ld ppb over %lu s -> using %ld ppb\n",
+                     (long)measured, (unsigned long)(ref_span / 1000000), (long)wall_clock_drift_ppb);
+      }
+      wall_clock_sync.cal_epoch_us = epoch_us;
+      wall_clock_sync.cal_rtc_us = rtc_now;
+    }
+  } else {
+    wall_clock_sync.cal_epoch_us = epoch_us;
+    wall_clock_sync.cal_rtc_us = rtc_now;
+  }
+
+  wall_clock_sync.epoch_us = epoch_us;
+  wall_clock_sync.rtc_us = rtc_now;
+  wall_clock_sync.tz_offset_s = tz_offset_s;
+  wall_clock_sync.checksum = wall_clock_checksum();
+  wall_clock_sync.magic = WALLCLOCK_MAGIC;
+
+  DEBUG_PRINTF("Wall clock set: %s (UTC%+ld min)\n", wall_clock_format(epoch_us).c_str(),
+               (long)(tz_offset_s / 60));
+}
+
+String wall_clock_format(int64_t epoch_us) {
+  time_t local = (time_t)(epoch_us / 1000000 + (wall_clock_valid() ? wall_clock_sync.tz_offset_s : 0));
+  struct tm parts;
+  gmtime_r(&local, &parts);
+  char buffer[24];
+  strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &parts);
+  return String(buffer);
+}
+
+bool wall_clock_next_time_of_day(uint32_t seconds_of_day, int64_t &epoch_us) {
+  // Nächstes Auftreten der lokalen Tageszeit - heute, sonst morgen
+  if (!wall_clock_valid() || seconds_of_day >= 86400) return false;
+  int64_t now_s = wall_clock_now_us() / 1000000;
+  int64_t local_s = now_s + wall_clock_sync.tz_offset_s;
+  int64_t target_s = local_s - (local_s % 86400) + seconds_of_day;
+  if (target_s <= local_s) target_s += 86400;
+  epoch_us = (target_s - wall_clock_sync.tz_offset_s) * 1000000;
+  return true;
+}
+
+bool wall_clock_parse_time_of_day(String text, uint32_t &seconds_of_day) {
+  text.trim();
+  int first_colon = text.indexOf(':');
+  if (first_colon < 1) return false;
+  int second_colon = text.indexOf(':', first_colon + 1);
+  long hours = text.substring(0, first_colon).toInt();
+  long minutes = text.substring(first_colon + 1, second_colon == -1 ? text.length() : second_colon).toInt();
+  long seconds = second_colon == -1 ? 0 : text.substring(second_colon + 1).toInt();
+  if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59 || seconds < 0 || seconds > 59) return false;
+  seconds_of_day = hours * 3600 + minutes * 60 + seconds;
+  return true;
+}
+
+bool wall_clock_start_at(int64_t epoch_us, TimerExecutionMode mode) {
+  if (!wall_clock_valid() || runtime.state != TIMER_IDLE) return false;
+
+  int64_t wait_us = epoch_us - wall_clock_now_us();
+  if (wait_us <= 0 || wait_us > (int64_t)VALUE_MAX_DURATION_S * 1000000) {
+    DEBUG_PRINTLN("Scheduled start rejected: time is in the past or too far ahead");
+    return false;
+  }
+
+  // Echte Wartezeit -> Trigger-Zeitbasis, die im Schlaf mit der RTC läuft
+  bool armed = start_execution_at(trigger_clock_now_us() + wait_us + wall_clock_drift_us(wait_us), mode);
+
+  if (armed) {
+    DEBUG_PRINTF("Run armed for %s (in %lu s)\n", wall_clock_format(epoch_us).c_str(),
+                 (unsigned long)(wait_us / 1000000));
+  }
+  return armed;
+}
+
+String wall_clock_status_string() {
+  char epoch_ms[24];
+  snprintf(epoch_ms, sizeof(epoch_ms), "%lld", (long long)(wall_clock_now_us() / 1000));
+  return String(epoch_ms) + ":" + String(wall_clock_valid() ? wall_clock_sync.tz_offset_s / 60 : 0) + ":" +
+         String(wall_clock_drift_ppb) + ":" + String(wall_clock_calibrated ? 1 : 0);
+}
+
+void print_wall_clock_status() {
+  Serial.println("=== Wall Clock ===");
+  if (!wall_clock_valid()) {
+    Serial.println("Not set (BLE CLOCK:<epoch_ms>:<tz_min> or 'clock set')");
+  } else {
+    Serial.printf("Local time: %s (UTC%+ld min)\n", wall_clock_format(wall_clock_now_us()).c_str(),
+                  (long)(wall_clock_sync.tz_offset_s / 60));
+    Serial.printf("Last sync: %lu s ago\n",
+                  (unsigned long)((trigger_clock_rtc_us() - wall_clock_sync.rtc_us) / 1000000));
+  }
+  Serial.printf("RTC drift: %ld ppb (%s, needs syncs >= %d s apart)\n", (long)wall_clock_drift_ppb,
+                wall_clock_calibrated ? "calibrated" : "uncalibrated", WALLCLOCK_MIN_CAL_S);
+  if (timer_run_armed()) {
+    Serial.printf("Armed run starts in %lu s\n",
+                  (unsigned long)((runtime.startTime - trigger_clock_now_us()) / 1000000));
+  }
+  Serial.println("==================");
+}
+
+#endif // WALL_CLOCK_H